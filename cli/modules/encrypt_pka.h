@@ -48,12 +48,15 @@ const Module encrypt_pka(
         std::make_pair("--sign", std::make_pair("private key file",                                 "")),
         std::make_pair("--sym",  std::make_pair("symmetric encryption algorithm",             "AES256")),
         std::make_pair("-h",     std::make_pair("hash_algorithm for signing",                   "SHA1")),
+        std::make_pair("--level",    std::make_pair("compression level (auto, -1 - 9)",             "auto")),
+        std::make_pair("--strategy", std::make_pair("compression strategy (DEFAULT, FILTERED, HUFFMAN_ONLY, RLE, FIXED)", "DEFAULT")),
     },
 
     // optional flags
     {
         std::make_pair("-a",    std::make_pair("armored",                                         true)),
         std::make_pair("--mdc", std::make_pair("use mdc?",                                        true)),
+        std::make_pair("--comp-stats", std::make_pair("report the compression decision",       false)),
     },
 
     // function to run
@@ -83,6 +86,20 @@ const Module encrypt_pka(
             return -1;
         }
 
+        int level = OpenPGP::Compression::LEVEL_AUTO;
+        if (args.at("--level") != "auto"){
+            std::stringstream s(args.at("--level"));
+            if (!(s >> level) || !s.eof() || (level < Z_DEFAULT_COMPRESSION) || (9 < level)){
+                err << "Error: Bad Compression Level: " << args.at("--level") << std::endl;
+                return -1;
+            }
+        }
+
+        if (OpenPGP::Compression::STRATEGY.find(args.at("--strategy")) == OpenPGP::Compression::STRATEGY.end()){
+            err << "Error: Bad Compression Strategy: " << args.at("--strategy") << std::endl;
+            return -1;
+        }
+
         if (OpenPGP::Sym::NUMBER.find(args.at("--sym")) == OpenPGP::Sym::NUMBER.end()){
             err << "Error: Bad Symmetric Key Algorithm: " << args.at("--sym") << std::endl;
             return -1;
@@ -111,7 +128,10 @@ const Module encrypt_pka(
                                                  flags.at("--mdc"),
                                                  signer,
                                                  args.at("-p"),
-                                                 OpenPGP::Hash::NUMBER.at(args.at("-h")));
+                                                 OpenPGP::Hash::NUMBER.at(args.at("-h")),
+                                                 level,
+                                                 OpenPGP::Compression::STRATEGY.at(args.at("--strategy")),
+                                                 flags.at("--comp-stats")?[&err](const OpenPGP::Compression::Decision & decision){ err << "Compression: " << OpenPGP::Compression::show(decision) << std::endl; }:OpenPGP::Compression::Observer());
 
         const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encryptargs, OpenPGP::PublicKey(key));
 
@@ -43,6 +43,8 @@ THE SOFTWARE.
 //    SHOULD implement ZIP. Implementations MAY implement any other
 //    algorithm.
 
+#include "Compress/Stream.h"
+#include "common/Status.h"
 #include "pgpbzip2.h"
 #include "pgpzlib.h"
 
@@ -82,8 +84,66 @@ namespace OpenPGP {
 
         bool valid(const uint8_t comp);
 
-        std::string compress(const uint8_t alg, const std::string & data);
+        // streaming (de)compressors for each algorithm
+        // level is the zlib level or the bzip2 block size; -1 uses the default
+        // strategy is a zlib strategy and is ignored by bzip2
+        Compressor::Ptr compressor(const uint8_t alg, const int level = Z_DEFAULT_COMPRESSION, const int strategy = Z_DEFAULT_STRATEGY);
+        Decompressor::Ptr decompressor(const uint8_t alg);
+
+        std::string compress(const uint8_t alg, const std::string & data, const int level = Z_DEFAULT_COMPRESSION, const int strategy = Z_DEFAULT_STRATEGY);
         std::string decompress(const uint8_t alg, const std::string & data);
+
+        // output is only compared against max_ratio once it is this large
+        constexpr std::size_t RATIO_GRACE = 1 << 20;
+
+        // limits on decompressing untrusted data; 0 means no limit
+        struct Budget {
+            std::size_t max_output;     // octets of decompressed output
+            double max_ratio;           // decompressed octets per compressed octet
+
+            Budget(const std::size_t output = 0, const double ratio = 0)
+                : max_output(output),
+                  max_ratio(ratio)
+            {}
+        };
+
+        // Decompression that stops as soon as a Budget is exceeded
+        //
+        // Output goes to the sink in small pieces. Once a call fails,
+        // every later call returns the same Status.
+        //
+        // Compressed data found inside of decompressed output should be
+        // read with a decompressor made from the outer one, so that
+        // max_ratio limits the expansion of all of the layers together
+        // instead of each layer on its own.
+        class BudgetedDecompressor {
+            private:
+                Decompressor::Ptr stream;
+                Budget budget;
+                std::shared_ptr <std::size_t> outermost;    // octets fed to the outermost decompressor
+                bool nested;
+                std::size_t consumed;
+                std::size_t produced;
+                Status status;
+
+            public:
+                BudgetedDecompressor(const uint8_t alg, const Budget & limits = Budget());
+                BudgetedDecompressor(const uint8_t alg, const BudgetedDecompressor & outer);
+
+                // SUCCESS, DECOMPRESSION_OUTPUT_LIMIT, DECOMPRESSION_RATIO_LIMIT,
+                // INVALID_COMPRESSED_DATA, or INVALID if the sink returned false
+                Status feed(const std::string & data, const Sink & sink);
+
+                // INVALID_COMPRESSED_DATA if the stream did not end
+                Status finish();
+
+                std::size_t get_consumed() const;
+                std::size_t get_produced() const;
+        };
+
+        // decompress data into sink within budget
+        // returns INVALID_COMPRESSION_ALGORITHM for unknown algorithms
+        Status decompress(const uint8_t alg, const std::string & data, const Sink & sink, const Budget & budget = Budget());
     }
 }
 
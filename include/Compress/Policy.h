@@ -0,0 +1,92 @@
+/*
+Policy.h
+Chooses whether and how hard to compress data
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_COMPRESS_POLICY__
+#define __OPENPGP_COMPRESS_POLICY__
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "Compress/Compress.h"
+
+namespace OpenPGP {
+    namespace Compression {
+        // let the policy pick the level
+        constexpr int LEVEL_AUTO = -2;
+
+        const std::map <std::string, int> STRATEGY = {
+            std::make_pair("DEFAULT",       Z_DEFAULT_STRATEGY),
+            std::make_pair("FILTERED",      Z_FILTERED),
+            std::make_pair("HUFFMAN_ONLY",  Z_HUFFMAN_ONLY),
+            std::make_pair("RLE",           Z_RLE),
+            std::make_pair("FIXED",         Z_FIXED),
+        };
+
+        // octets at the start of the data that are examined
+        constexpr std::size_t POLICY_SAMPLE = 65536;
+
+        // sample entropy (bits per octet) above which data is not compressed
+        constexpr double POLICY_MAX_ENTROPY = 7.9;
+
+        // compressed / original size of the sample above which data is not
+        // compressed, and above which only the fastest level is used
+        constexpr double POLICY_SKIP_RATIO = 0.95;
+        constexpr double POLICY_FAST_RATIO = 0.80;
+
+        // outcome of the policy, for callers that want to report it
+        struct Decision {
+            uint8_t alg;                // algorithm to use; UNCOMPRESSED if compression was skipped
+            int level;
+            int strategy;
+            std::size_t size;           // octets of input
+            std::size_t sampled;        // octets examined
+            double entropy;             // bits per octet of the sample, or -1 if not measured
+            double ratio;               // trial compression ratio of the sample, or -1 if not measured
+            std::string reason;
+        };
+
+        typedef std::function <void (const Decision &)> Observer;
+
+        // Shannon entropy in bits per octet
+        double entropy(const std::string & data);
+
+        // Decide how to compress data that was requested to be compressed
+        // with alg.
+        //
+        // An explicit level is used as given. With LEVEL_AUTO, the start of
+        // the data is sampled: data that looks random or does not shrink in
+        // a trial compression is left uncompressed, data that shrinks a
+        // little is compressed with the fastest level, and anything else
+        // uses the default level.
+        Decision decide(const uint8_t alg, const std::string & data, const int level = LEVEL_AUTO, const int strategy = Z_DEFAULT_STRATEGY);
+
+        // one line summary of a decision
+        std::string show(const Decision & decision);
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+Stream.h
+Interfaces for incremental compression and decompression
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_COMPRESS_STREAM__
+#define __OPENPGP_COMPRESS_STREAM__
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace OpenPGP {
+    namespace Compression {
+        // Incremental compression
+        //
+        // Input is fed in pieces with update() and the stream is
+        // terminated with finish(). Each call returns only the output
+        // that became available, so memory use is bounded by the size of
+        // the pieces instead of the size of the whole input.
+        class Compressor {
+            public:
+                typedef std::shared_ptr <Compressor> Ptr;
+
+                virtual ~Compressor() {}
+
+                virtual std::string update(const std::string & data) = 0;
+                virtual std::string finish() = 0;
+        };
+
+        // receives decompressed output a piece at a time;
+        // returning false stops decompression
+        typedef std::function <bool (const std::string &)> Sink;
+
+        // Incremental decompression
+        //
+        // Octets after the end of the compressed stream are ignored.
+        // finish() throws if the stream did not end.
+        //
+        // update() returns all of the output of its input at once, which
+        // can be far larger than the input. feed() instead hands the output
+        // to a sink in pieces of at most a few KB as it is produced.
+        class Decompressor {
+            public:
+                typedef std::shared_ptr <Decompressor> Ptr;
+
+                virtual ~Decompressor() {}
+
+                // returns false if the sink stopped decompression
+                virtual bool feed(const std::string & data, const Sink & sink) = 0;
+
+                std::string update(const std::string & data) {
+                    std::string out;
+                    feed(data, [&out](const std::string & piece) { out += piece; return true; });
+                    return out;
+                }
+
+                virtual std::string finish() = 0;
+
+                // whether or not the end of the compressed stream was seen
+                virtual bool done() const = 0;
+        };
+    }
+}
+
+#endif
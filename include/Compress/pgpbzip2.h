@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <cstddef>
 #include <string>
 
 #include <bzlib.h>
@@ -35,3 +36,54 @@ const unsigned int bz2_SMALL = 0;                           // 0 or 1
 
 int bz2_compress  (const std::string & src, std::string & dst);
 int bz2_decompress(const std::string & src, std::string & dst);
+
+// lbzip2-style compression: the input is cut into pieces that each fit in
+// one bzip2 block, the pieces are compressed on separate threads, and the
+// blocks are spliced into a single standard stream
+//
+// threads = 0 uses one thread per hardware thread
+int bz2_compress_parallel  (const std::string & src, std::string & dst, int blocksize100k = bz2_BLOCKSIZE100K, std::size_t threads = 0);
+
+// finds the blocks of the first stream in src by their magic numbers and
+// decompresses them on separate threads; falls back to bz2_decompress
+// when the stream cannot be split
+int bz2_decompress_parallel(const std::string & src, std::string & dst, std::size_t threads = 0);
+
+#include "Compress/Stream.h"
+
+namespace OpenPGP {
+    namespace Compression {
+        class Bz2Compressor : public Compressor {
+            private:
+                bz_stream strm;
+                bool finished;
+
+                std::string run(const std::string & data, const int action);
+
+            public:
+                Bz2Compressor(const int blocksize100k = bz2_BLOCKSIZE100K);
+                Bz2Compressor(const Bz2Compressor &) = delete;
+                Bz2Compressor & operator=(const Bz2Compressor &) = delete;
+                ~Bz2Compressor();
+
+                std::string update(const std::string & data);
+                std::string finish();
+        };
+
+        class Bz2Decompressor : public Decompressor {
+            private:
+                bz_stream strm;
+                bool ended;
+
+            public:
+                Bz2Decompressor();
+                Bz2Decompressor(const Bz2Decompressor &) = delete;
+                Bz2Decompressor & operator=(const Bz2Decompressor &) = delete;
+                ~Bz2Decompressor();
+
+                bool feed(const std::string & data, const Sink & sink);
+                std::string finish();
+                bool done() const;
+        };
+    }
+}
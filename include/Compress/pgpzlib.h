@@ -1,5 +1,6 @@
 // Adapted from the public domain file http://www.zlib.net/zpipe.c
 
+#include <cstddef>
 #include <string>
 
 #include <zlib.h>
@@ -15,12 +16,65 @@
 #define ZLIB_CHUNK 16384
 #define ZLIB_WINDOWBITS 15      // ZLIB format
 #define DEFLATE_WINDOWBITS -15  // Raw DEFLATE
+#define ZLIB_DICTIONARY 32768   // history carried into each parallel block
+#define ZLIB_PARALLEL_BLOCK 131072
 
 // level:
 //      -1 - 9
 //      Z_DEFAULT_COMPRESSION = -1 = 6
 //      0 = no compression
 //      9 = slowest compression
+//
+// strategy:
+//      Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, or Z_FIXED
 
 int zlib_compress  (const std::string & src, std::string & dst, int windowBits, int level = Z_DEFAULT_COMPRESSION);
 int zlib_decompress(const std::string & src, std::string & dst, int windowBits);
+
+// pigz-style compression: blocks of src are deflated on separate threads,
+// each primed with the preceding ZLIB_DICTIONARY octets, and joined with
+// sync flushes into a single stream any inflater can read
+//
+// windowBits must be ZLIB_WINDOWBITS or DEFLATE_WINDOWBITS
+// threads = 0 uses one thread per hardware thread
+int zlib_compress_parallel(const std::string & src, std::string & dst, int windowBits, int level = Z_DEFAULT_COMPRESSION, int strategy = Z_DEFAULT_STRATEGY, std::size_t threads = 0, std::size_t block = ZLIB_PARALLEL_BLOCK);
+
+#include "Compress/Stream.h"
+
+namespace OpenPGP {
+    namespace Compression {
+        // windowBits selects the format: ZLIB_WINDOWBITS or DEFLATE_WINDOWBITS
+        class ZlibCompressor : public Compressor {
+            private:
+                z_stream strm;
+                bool finished;
+
+                std::string run(const std::string & data, const int flush);
+
+            public:
+                ZlibCompressor(const int windowBits, const int level = Z_DEFAULT_COMPRESSION, const int strategy = Z_DEFAULT_STRATEGY);
+                ZlibCompressor(const ZlibCompressor &) = delete;
+                ZlibCompressor & operator=(const ZlibCompressor &) = delete;
+                ~ZlibCompressor();
+
+                std::string update(const std::string & data);
+                std::string finish();
+        };
+
+        class ZlibDecompressor : public Decompressor {
+            private:
+                z_stream strm;
+                bool ended;
+
+            public:
+                ZlibDecompressor(const int windowBits);
+                ZlibDecompressor(const ZlibDecompressor &) = delete;
+                ZlibDecompressor & operator=(const ZlibDecompressor &) = delete;
+                ~ZlibDecompressor();
+
+                bool feed(const std::string & data, const Sink & sink);
+                std::string finish();
+                bool done() const;
+        };
+    }
+}
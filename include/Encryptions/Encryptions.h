@@ -42,6 +42,10 @@ THE SOFTWARE.
 #include "TDES.h"
 #include "Twofish.h"
 
+#ifdef OPENSSL_SYM
+#include "OpenSSL/EVP.h"
+#endif
+
 namespace OpenPGP {
     namespace Sym {
         // 9.2.  Symmetric-Key Algorithms
@@ -159,6 +163,8 @@ namespace OpenPGP {
         const std::string TDES_mode2 = "d";
         const std::string TDES_mode3 = "e";
 
+        // uses the OpenSSL backend when it is selected and
+        // provides sym_alg, and the built-in cipher otherwise
         SymAlg::Ptr setup(const uint8_t sym_alg, const std::string & key);
     }
 }
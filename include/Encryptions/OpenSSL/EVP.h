@@ -0,0 +1,72 @@
+/*
+EVP.h
+Block ciphers provided by OpenSSL's EVP interface
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENSSL_SYM_EVP__
+#define __OPENSSL_SYM_EVP__
+
+#include <openssl/evp.h>
+
+#include "Encryptions/SymAlg.h"
+
+namespace OpenPGP {
+    namespace Sym {
+
+        // Raw block encryption for any OpenPGP symmetric
+        // algorithm that the linked OpenSSL provides
+        //
+        // The cipher runs in ECB mode without padding so that it
+        // can stand in for the built-in ciphers underneath the
+        // OpenPGP CFB code. Input must be a whole number of blocks.
+        class EVP : public SymAlg {
+            private:
+                uint8_t alg;
+                EVP_CIPHER_CTX * enc;
+                EVP_CIPHER_CTX * dec;
+
+                std::string run(EVP_CIPHER_CTX * ctx, const std::string & data);
+
+            public:
+                // cipher for the OpenPGP symmetric algorithm, or nullptr
+                static const EVP_CIPHER * cipher(const uint8_t alg);
+
+                // whether or not OpenSSL can run alg
+                static bool supported(const uint8_t alg);
+
+                // whether or not alg should currently be run with EVP
+                static bool enabled(const uint8_t alg);
+
+                EVP(const uint8_t alg, const std::string & key);
+                EVP(const EVP & copy) = delete;
+                EVP & operator=(const EVP & copy) = delete;
+                ~EVP();
+
+                std::string encrypt(const std::string & DATA);
+                std::string decrypt(const std::string & DATA);
+                unsigned int blocksize() const;
+        };
+    }
+}
+
+#endif
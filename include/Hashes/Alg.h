@@ -35,8 +35,9 @@ namespace OpenPGP {
                 Alg();
                 virtual ~Alg();
                 virtual std::string hexdigest() = 0;
-                std::string digest();
+                virtual std::string digest();
                 virtual void update(const std::string & str) = 0;
+                virtual void update(const char * data, const std::size_t len);
                 virtual std::size_t digestsize() const = 0; // digest size in bits
         };
     }
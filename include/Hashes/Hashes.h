@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include <map>
 #include <memory>
+#include <stdexcept>
 
 #include "Hashes/Alg.h"
 
@@ -39,6 +40,10 @@ THE SOFTWARE.
 #include "Hashes/SHA512.h"
 #include "Hashes/SHA384.h"
 
+#ifdef OPENSSL_HASH
+#include "Hashes/OpenSSL/EVP.h"
+#endif
+
 namespace OpenPGP {
     namespace Hash {
 
@@ -130,10 +135,108 @@ namespace OpenPGP {
 
         bool valid(const uint8_t alg);
 
+        // digest size in bits without going through LENGTH
+        std::size_t length(const uint8_t alg);
+
         std::string use(const uint8_t alg, const std::string & data = "");
 
         typedef std::shared_ptr <Alg> Instance;
         Instance get_instance(const uint8_t alg, const std::string & data = "");
+
+        // Compile time mapping of hash algorithm IDs to implementations
+        //
+        // Contexts created through these live on the stack and
+        // their member functions are bound at compile time, so
+        // internal hot paths (S2K, fingerprints, MDC) do not need
+        // to allocate an Instance or go through virtual calls.
+        template <uint8_t alg> struct Traits;
+
+        template <> struct Traits <ID::MD5>       { typedef Hash::MD5       Type; static constexpr std::size_t LENGTH = 128; };
+        template <> struct Traits <ID::SHA1>      { typedef Hash::SHA1      Type; static constexpr std::size_t LENGTH = 160; };
+        template <> struct Traits <ID::RIPEMD160> { typedef Hash::RIPEMD160 Type; static constexpr std::size_t LENGTH = 160; };
+        template <> struct Traits <ID::SHA256>    { typedef Hash::SHA256    Type; static constexpr std::size_t LENGTH = 256; };
+        template <> struct Traits <ID::SHA384>    { typedef Hash::SHA384    Type; static constexpr std::size_t LENGTH = 384; };
+        template <> struct Traits <ID::SHA512>    { typedef Hash::SHA512    Type; static constexpr std::size_t LENGTH = 512; };
+        template <> struct Traits <ID::SHA224>    { typedef Hash::SHA224    Type; static constexpr std::size_t LENGTH = 224; };
+
+        // Hash context for a given algorithm ID
+        //
+        // The built-in implementation lives on the stack. When the
+        // OpenSSL backend is selected and provides alg, data goes to
+        // an EVP context instead.
+        template <uint8_t alg>
+        class Context {
+            private:
+                typename Traits <alg>::Type builtin;
+                #ifdef OPENSSL_HASH
+                std::unique_ptr <EVP> evp;
+                #endif
+
+            public:
+                Context(const std::string & data = "")
+                    : builtin()
+                      #ifdef OPENSSL_HASH
+                      , evp(EVP::enabled(alg)?new EVP(alg):nullptr)
+                      #endif
+                {
+                    update(data);
+                }
+
+                void update(const std::string & data) {
+                    #ifdef OPENSSL_HASH
+                    if (evp) {
+                        evp -> update(data);
+                        return;
+                    }
+                    #endif
+                    builtin.update(data);
+                }
+
+                std::string digest() {
+                    #ifdef OPENSSL_HASH
+                    if (evp) {
+                        return evp -> digest();
+                    }
+                    #endif
+                    return builtin.digest();
+                }
+
+                std::size_t digestsize() const {
+                    return Traits <alg>::LENGTH;
+                }
+        };
+
+        // Run func on a stack allocated context of the given algorithm
+        //
+        // Func must define result_type and a templated
+        // operator()(H & ctx) that works on any context type.
+        // Inside func, ctx.H::update(...) is a direct call.
+        //
+        // When the OpenSSL backend is selected and provides alg,
+        // func receives an EVP context instead.
+        template <typename Func>
+        typename Func::result_type dispatch(const uint8_t alg, const Func & func) {
+            #ifdef OPENSSL_HASH
+            if (EVP::enabled(alg)) {
+                EVP ctx(alg);
+                return func(ctx);
+            }
+            #endif
+
+            switch (alg) {
+                case ID::MD5:       { Traits <ID::MD5>::Type       ctx; return func(ctx); }
+                case ID::SHA1:      { Traits <ID::SHA1>::Type      ctx; return func(ctx); }
+                case ID::RIPEMD160: { Traits <ID::RIPEMD160>::Type ctx; return func(ctx); }
+                case ID::SHA256:    { Traits <ID::SHA256>::Type    ctx; return func(ctx); }
+                case ID::SHA384:    { Traits <ID::SHA384>::Type    ctx; return func(ctx); }
+                case ID::SHA512:    { Traits <ID::SHA512>::Type    ctx; return func(ctx); }
+                case ID::SHA224:    { Traits <ID::SHA224>::Type    ctx; return func(ctx); }
+                default:
+                    break;
+            }
+
+            throw std::runtime_error("Error: Hash value not defined or reserved.");
+        }
     }
 }
 
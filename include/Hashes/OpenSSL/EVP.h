@@ -0,0 +1,70 @@
+/*
+EVP.h
+Hash algorithms provided by OpenSSL's EVP interface
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENSSL_HASH_EVP__
+#define __OPENSSL_HASH_EVP__
+
+#include <openssl/evp.h>
+
+#include "Hashes/Alg.h"
+
+namespace OpenPGP {
+    namespace Hash {
+
+        // Any OpenPGP hash algorithm that the linked OpenSSL
+        // provides, computed through EVP_Digest*
+        //
+        // Unlike the built-in implementations, digest() returns
+        // raw bytes directly and may be called more than once.
+        class EVP : public Alg {
+            private:
+                uint8_t alg;
+                EVP_MD_CTX * ctx;
+
+            public:
+                // message digest for the OpenPGP hash algorithm, or nullptr
+                static const EVP_MD * md(const uint8_t alg);
+
+                // whether or not OpenSSL can compute alg
+                static bool supported(const uint8_t alg);
+
+                // whether or not alg should currently be computed with EVP
+                static bool enabled(const uint8_t alg);
+
+                EVP(const uint8_t alg, const std::string & data = "");
+                EVP(const EVP & copy);
+                EVP & operator=(const EVP & copy);
+                ~EVP();
+
+                void update(const std::string & str);
+                void update(const char * data, const std::size_t len);
+                std::string digest();
+                std::string hexdigest();
+                std::size_t digestsize() const;
+        };
+    }
+}
+
+#endif
@@ -26,10 +26,6 @@ THE SOFTWARE.
 #ifndef __OPENPGP_SHA1__
 #define __OPENPGP_SHA1__
 
-#ifdef OPENSSL_HASH
-#include "Hashes/OpenSSL/SHA1.h"
-#else
 #include "Hashes/Unsafe/SHA1.h"
-#endif
 
 #endif
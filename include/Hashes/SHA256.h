@@ -26,10 +26,6 @@ THE SOFTWARE.
 #ifndef __OPENPGP_SHA256__
 #define __OPENPGP_SHA256__
 
-#ifdef OPENSSL_HASH
-#include "Hashes/OpenSSL/SHA256.h"
-#else
 #include "Hashes/Unsafe/SHA256.h"
-#endif
 
 #endif
@@ -26,10 +26,6 @@ THE SOFTWARE.
 #ifndef __OPENPGP_SHA384__
 #define __OPENPGP_SHA384__
 
-#ifdef OPENSSL_HASH
-#include "Hashes/OpenSSL/SHA384.h"
-#else
 #include "Hashes/Unsafe/SHA384.h"
-#endif
 
 #endif
@@ -27,9 +27,14 @@ THE SOFTWARE.
 #define __OPENPGP_MESSAGE__
 
 #include <list>
+#include <memory>
 
+#include "Compress/Compress.h"
 #include "PGP.h"
+#include "Packets/Partial.h"
 #include "Packets/Tag8.h"
+#include "common/Output.h"
+#include "common/Status.h"
 
 namespace OpenPGP {
 
@@ -142,6 +147,50 @@ namespace OpenPGP {
             PGP::Ptr clone() const;
     };
 
+    // Reads the packets of a binary OpenPGP Message as they arrive
+    //
+    // Compressed Data Packets are decompressed under budget and their
+    // contents are read in place. The contents of Literal Data Packets
+    // go to literal. All other packets go to other in pieces, as with
+    // Packet::PacketReader.
+    //
+    // Handlers stop reading by throwing std::runtime_error, which
+    // becomes INVALID. Once a call fails, every later call returns the
+    // same Status.
+    class MessageReader {
+        private:
+            Output literal;
+            Packet::PacketReader::Handler other;
+            Compression::Budget budget;
+            std::size_t depth;                  // Compressed Data Packets around this one
+            Status status;
+            Packet::PacketReader reader;
+            std::string header;                 // packet header fields read so far
+            bool in_body;                       // whether or not header is complete
+            std::shared_ptr <Compression::BudgetedDecompressor> outer;  // decompressor this message came out of
+            std::shared_ptr <Compression::BudgetedDecompressor> decompressor;
+            std::shared_ptr <MessageReader> inner;
+
+            void read_packet(const uint8_t tag, const std::string & data, const bool last);
+            void read_literal(const std::string & data, const bool last);
+            void read_compressed(const std::string & data, const bool last);
+
+        public:
+            static const std::size_t MAX_DEPTH = 8;
+
+            MessageReader(const Output & literal,
+                          const Packet::PacketReader::Handler & other = nullptr,
+                          const Compression::Budget & budget = Compression::Budget(),
+                          const std::size_t depth = 0);
+            MessageReader(const MessageReader & copy) = delete;
+            MessageReader & operator=(const MessageReader & copy) = delete;
+
+            Status update(const std::string & data);
+
+            // INVALID_LENGTH if the data ended inside of a packet
+            Status finish();
+    };
+
 }
 
 #endif
@@ -0,0 +1,77 @@
+/*
+FixedBase.h
+Precomputed powers of a fixed base for repeated exponentiation
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __FIXED_BASE__
+#define __FIXED_BASE__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Misc/mpi.h"
+
+namespace OpenPGP {
+
+    // Table of base^(d * 2^(WINDOW * i)) mod mod for every window i
+    // and digit d, so that base^exp is a product of one table entry
+    // per window and needs no squarings
+    //
+    // Entries are selected with mpn_sec_tabselect and multiplied with
+    // mpn_sec_mul/mpn_sec_div_r, so powm_sec does not leak exp through
+    // timing or memory access. This is meant for the generator of a
+    // DSA or ElGamal domain, which is reused for every signature or
+    // encryption. The table takes exp_bits / WINDOW * 2^WINDOW entries
+    // the size of mod.
+    class FixedBase {
+        public:
+            static const std::size_t WINDOW = 4;
+
+            typedef std::shared_ptr <FixedBase> Ptr;
+
+        private:
+            MPI base_;
+            MPI mod_;
+            std::size_t bits;           // largest exponent in bits
+            std::size_t limbs;          // size of mod in limbs
+            std::vector <mp_limb_t> table;
+
+        public:
+            // mod must be odd; exponents must be less than 2^exp_bits
+            FixedBase(const MPI & base, const MPI & mod, const std::size_t exp_bits);
+
+            // base^exp mod mod
+            MPI powm_sec(const MPI & exp) const;
+
+            // whether or not this table computes powers of base mod mod
+            bool matches(const MPI & base, const MPI & mod) const;
+
+            const MPI & get_base() const;
+            const MPI & get_mod() const;
+            std::size_t get_exp_bits() const;
+    };
+
+}
+
+#endif
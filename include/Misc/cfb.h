@@ -44,6 +44,26 @@ namespace OpenPGP {
     // Helper functions
     std::string use_normal_CFB_encrypt(const uint8_t sym_alg, const std::string & data, const std::string & key, const std::string & IV);
     std::string use_normal_CFB_decrypt(const uint8_t sym_alg, const std::string & data, const std::string & key, const std::string & IV);
+
+    // Incremental standard CFB
+    //
+    // Data can be given in pieces of any size. OpenPGP CFB without
+    // resynchronization (Tag 18) is standard CFB with an all zero IV
+    // over the prefix followed by the data.
+    class CFB {
+        private:
+            SymAlg::Ptr crypt;
+            bool decrypting;
+            std::string feedback;   // ciphertext of the current block
+            std::string keystream;  // encryption of the previous ciphertext block
+            std::size_t used;       // octets of the current block processed
+
+        public:
+            // an empty IV is all zeros
+            CFB(const SymAlg::Ptr & crypt, const bool decrypt, const std::string & IV = "");
+
+            std::string update(const std::string & data);
+    };
 }
 
 #endif
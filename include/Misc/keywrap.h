@@ -1,7 +1,6 @@
 /*
-RIPEMD160.h
-RIPEMD160 hash function
-http://homes.esat.kuleuven.be/~bosselae/ripemd160.html
+keywrap.h
+AES Key Wrap (RFC 3394)
 
 Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
 
@@ -24,28 +23,22 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
-#ifndef __OPENSSL_RIPEMD160__
-#define __OPENSSL_RIPEMD160__
+#ifndef __KEYWRAP__
+#define __KEYWRAP__
 
-#include <openssl/ripemd.h>
-
-#include "Hashes/MerkleDamgard.h"
+#include "Encryptions/Encryptions.h"
 
 namespace OpenPGP {
-    namespace Hash {
-        class RIPEMD160 : public MerkleDamgard {
-            private:
-                RIPEMD160_CTX ctx;
-
-            public:
-                RIPEMD160();
-                RIPEMD160(const std::string & data);
-                void update(const std::string & data);
-                std::string hexdigest();
-                std::size_t blocksize() const;
-                std::size_t digestsize() const;
-        };
-    }
+    // RFC 3394 key wrap with the default IV
+    //
+    // data must be a multiple of 8 octets and at least 16 octets long;
+    // crypt must have a 128 bit block. Unwrap returns an empty string
+    // if the input is malformed or the integrity check fails.
+    std::string key_wrap(const SymAlg::Ptr & crypt, const std::string & data);
+    std::string key_unwrap(const SymAlg::Ptr & crypt, const std::string & data);
+    // Helper functions
+    std::string use_key_wrap(const uint8_t sym_alg, const std::string & data, const std::string & key);
+    std::string use_key_unwrap(const uint8_t sym_alg, const std::string & data, const std::string & key);
 }
 
 #endif
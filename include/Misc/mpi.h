@@ -50,9 +50,26 @@ namespace OpenPGP {
     bool knuth_prime_test(const MPI & a, int test);
 
     void mpiswap(MPI & a, MPI & b);
+
+    // overwrite the limbs of a secret value with zeros, leaving a = 0
+    void mpiwipe(MPI & a);
     MPI mpigcd(const MPI & a, const MPI & b);
     MPI nextprime(const MPI & a);
+
+    // Modular exponentiation
+    //
+    // powm_sec takes the same time and memory access pattern
+    // regardless of exp and must be used whenever exp is secret
+    // (private keys, nonces). powm_pub is much faster and is only
+    // for public exponents (RSA e, signature verification).
+    // powm is kept as the safe default and is the same as powm_sec.
+    MPI powm_sec(const MPI & base, const MPI & exp, const MPI & mod);
+    MPI powm_pub(const MPI & base, const MPI & exp, const MPI & mod);
     MPI powm(const MPI & base, const MPI & exp, const MPI & mod);
+
+    // base1^exp1 * base2^exp2 mod mod in one pass over both exponents
+    // (Shamir/Straus); public exponents only
+    MPI powm2_pub(const MPI & base1, const MPI & exp1, const MPI & base2, const MPI & exp2, const MPI & mod);
     MPI invert(const MPI & a, const MPI & b);
 
     MPI random(unsigned int bits);
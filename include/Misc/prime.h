@@ -0,0 +1,62 @@
+/*
+prime.h
+Multithreaded prime generation for key generation
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __PRIME__
+#define __PRIME__
+
+#include <cstddef>
+
+#include "Misc/mpi.h"
+
+namespace OpenPGP {
+    namespace Prime {
+
+        // Candidates are split into chunks of CHUNK values. Each worker
+        // thread claims a chunk, removes multiples of the small primes
+        // below SIEVE_LIMIT, and runs ROUNDS rounds of Miller-Rabin on
+        // the survivors. Once any worker finds a prime, the others stop
+        // at their next candidate.
+        //
+        // The RNG is only used by the calling thread.
+        constexpr std::size_t CHUNK       = 1024;
+        constexpr unsigned int SIEVE_LIMIT = 8192;
+        constexpr int ROUNDS               = 25;
+
+        // number of worker threads used when 0 is requested
+        unsigned int default_threads();
+
+        // a prime of the form start + k * step with k >= 0
+        //
+        // This is not necessarily the smallest such prime. start
+        // and step must be positive and coprime.
+        MPI progression(const MPI & start, const MPI & step, unsigned int threads = 0);
+
+        // random prime of exactly bits bits, with the top two bits set
+        // so that the product of two such primes has exactly 2 * bits bits
+        MPI random(const std::size_t bits, unsigned int threads = 0);
+    }
+}
+
+#endif
@@ -53,6 +53,9 @@ namespace OpenPGP {
     //    at the end of the Signature packet.
     std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig);
 
+    // the octets addtrailer appends, for hashing data that is not held in memory
+    std::string gettrailer(const Packet::Tag2::Ptr & sig);
+
     // Signature over a Packet::Key
     //
     //    When a signature is made over a Packet::Key, the hash data starts with the
@@ -0,0 +1,66 @@
+/*
+Curve25519.h
+Field arithmetic modulo 2^255 - 19
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __CURVE25519__
+#define __CURVE25519__
+
+#include <cstdint>
+#include <string>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Curve25519 {
+            // Field element stored as 5 limbs of 51 bits, least
+            // significant first. Limbs may briefly exceed 51 bits
+            // between operations; to_bytes fully reduces.
+            struct FE {
+                uint64_t v[5];
+            };
+
+            FE from_int(const uint32_t n);
+            FE from_bytes(const std::string & s);   // 32 octets, little endian, top bit ignored
+            std::string to_bytes(const FE & f);     // 32 octets, little endian, fully reduced
+
+            FE add(const FE & a, const FE & b);
+            FE sub(const FE & a, const FE & b);
+            FE neg(const FE & a);
+            FE mul(const FE & a, const FE & b);
+            FE mul_small(const FE & a, const uint32_t n);
+            FE sq(const FE & a);
+            FE sq(const FE & a, unsigned int n);    // a^(2^n)
+            FE invert(const FE & a);                // a^(p - 2)
+            FE pow22523(const FE & a);              // a^((p - 5) / 8)
+
+            bool is_zero(const FE & a);
+            bool is_negative(const FE & a);         // lowest bit of the reduced value
+
+            // constant time: f = b ? g : f and (f, g) = b ? (g, f) : (f, g)
+            void cmov(FE & f, const FE & g, const uint64_t b);
+            void cswap(FE & f, FE & g, const uint64_t b);
+        }
+    }
+}
+
+#endif
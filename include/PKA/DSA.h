@@ -28,8 +28,11 @@ THE SOFTWARE.
 
 #include "RNG/RNGs.h"
 #include "common/includes.h"
+#include "Misc/FixedBase.h"
 #include "Misc/mpi.h"
 #include "Misc/pgptime.h"
+#include "Misc/prime.h"
+#include "NoncePool.h"
 #include "PKA.h"
 
 namespace OpenPGP {
@@ -41,9 +44,42 @@ namespace OpenPGP {
             // Generate new keypair with parameters
             Values keygen(Values & pub);
 
+            // Precompute powers of g for signing with the domain parameters in pub
+            FixedBase::Ptr precompute(const Values & pub);
+
             // Sign hash of data
-            Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k = 0);
-            Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k = 0);
+            //
+            // If g_table is given, it must have been made by
+            // precompute() with the same p and g.
+            Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k = 0, const FixedBase::Ptr & g_table = nullptr);
+            Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k = 0, const FixedBase::Ptr & g_table = nullptr);
+
+            // Message independent half of a signature
+            struct Nonce {
+                MPI k_inv;  // k^-1 mod q
+                MPI r;      // (g^k mod p) mod q
+            };
+
+            // Pool of nonces for one set of domain parameters
+            //
+            // Sign::with_pka does not keep one, since it has no state to
+            // hold a thread in. Long running signers make a Pool for their
+            // key and call the Pool overloads of sign() directly.
+            typedef NoncePool <Nonce> Pool;
+
+            // zero a nonce that will not be used
+            void wipe(Nonce & nonce);
+
+            // fresh nonce for the domain parameters in pub
+            Nonce nonce(const Values & pub, const FixedBase::Ptr & g_table = nullptr);
+
+            // Online signing step: s = k^-1 (m + x * r) mod q
+            //
+            // Each nonce must only be used once. The Pool overloads
+            // take a new nonce for every signature.
+            Values sign(const MPI & data, const Values & pri, const Values & pub, const Nonce & nonce);
+            Values sign(const MPI & data, const Values & pri, const Values & pub, Pool & pool);
+            Values sign(const std::string & data, const Values & pri, const Values & pub, Pool & pool);
 
             // Verify signature on hash
             bool verify(const MPI & data, const Values & sig, const Values & pub);
@@ -0,0 +1,70 @@
+/*
+ECDH.h
+OpenPGP ECDH (RFC 6637) over Curve25519
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDH__
+#define __ECDH__
+
+#include "RNG/RNGs.h"
+#include "Hashes/Hashes.h"
+#include "Misc/keywrap.h"
+#include "Misc/mpi.h"
+#include "common/includes.h"
+#include "PKA.h"
+#include "X25519.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDH {
+            // Values as stored in OpenPGP packets:
+            //     public key = {0x40 || U}
+            //     private key = {k}
+            //     encrypted session key = {0x40 || V} + wrapped key
+            // with U and V raw little endian X25519 u-coordinates and
+            // k the X25519 scalar read as a little endian integer
+
+            // KDF parameters, RFC 6637 sec 8
+            //
+            // curve is the OID without its length octet and fingerprint
+            // is the 20 octet fingerprint of the recipient key.
+            std::string param(const std::string & curve, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & fingerprint);
+
+            // RFC 6637 sec 7: leftmost bytes of Hash(00 00 00 01 || Z || param)
+            std::string kdf(const uint8_t kdf_hash, const std::string & Z, const std::size_t bytes, const std::string & param);
+
+            // Generate new keypair; pub is overwritten with the public key
+            Values keygen(Values & pub);
+
+            // Encrypt data (symmetric algorithm || session key || checksum)
+            //
+            // Returns {0x40 || V}; the wrapped key is written to wrapped.
+            Values encrypt(const std::string & data, const Values & pub, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & param, std::string & wrapped);
+
+            // Returns the data given to encrypt, or an empty string on failure
+            std::string decrypt(const Values & c, const std::string & wrapped, const Values & pri, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & param);
+        }
+    }
+}
+
+#endif
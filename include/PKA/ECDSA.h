@@ -0,0 +1,60 @@
+/*
+ECDSA.h
+Elliptic Curve Digital Signature Algorithm over NIST P-256 and P-384
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDSA__
+#define __ECDSA__
+
+#include "RNG/RNGs.h"
+#include "Misc/mpi.h"
+#include "common/includes.h"
+#include "PKA.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDSA {
+            // Values as stored in OpenPGP packets:
+            //     public key = {0x04 || x || y}
+            //     private key = {d}
+            //     signature = {r, s}
+            //
+            // curve is the raw OID (without its length octet) from the key
+            // packet; only NIST P-256 and P-384 are implemented.
+            bool supported(const std::string & curve);
+
+            // Generate new keypair; pub is overwritten with the public key
+            Values keygen(const std::string & curve, Values & pub);
+
+            // Sign hash of data
+            //
+            // k is the per-signature secret; a random one is used when 0.
+            Values sign(const std::string & digest, const Values & pri, const Values & pub, const std::string & curve, MPI k = 0);
+
+            // Verify signature on hash
+            bool verify(const std::string & digest, const Values & sig, const Values & pub, const std::string & curve);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+Ed25519.h
+Edwards-curve Digital Signature Algorithm over Curve25519 (RFC 8032)
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ED25519__
+#define __ED25519__
+
+#include <cstddef>
+#include <string>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Ed25519 {
+            // All keys, signatures, and encodings are the raw octet
+            // strings from RFC 8032: 32 octet secret seed, 32 octet
+            // public key, 64 octet signature (R || S).
+            const std::size_t SEED_SIZE      = 32;
+            const std::size_t PUBLIC_SIZE    = 32;
+            const std::size_t SIGNATURE_SIZE = 64;
+
+            // Derive public key from secret seed
+            std::string public_key(const std::string & seed);
+
+            // Sign a message
+            //
+            // pub must be public_key(seed); it is recomputed when empty.
+            std::string sign(const std::string & message, const std::string & seed, const std::string & pub = "");
+
+            // Verify signature on message
+            bool verify(const std::string & message, const std::string & sig, const std::string & pub);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+EdDSA.h
+OpenPGP EdDSA (Ed25519) keys and signatures
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __EDDSA__
+#define __EDDSA__
+
+#include "RNG/RNGs.h"
+#include "common/includes.h"
+#include "Misc/mpi.h"
+#include "Ed25519.h"
+#include "PKA.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace EdDSA {
+            // Values as stored in OpenPGP packets:
+            //     public key = {0x40 || A}
+            //     private key = {seed}
+            //     signature = {R, S}
+            // with A, R, and S the raw little endian Ed25519 octets
+
+            // whether or not curve (raw OID octets) is Ed25519, the only curve supported
+            bool supported(const std::string & curve);
+
+            // Generate new keypair; pub is overwritten with the public key
+            Values keygen(Values & pub);
+
+            // Sign hash of data
+            Values sign(const std::string & digest, const Values & pri, const Values & pub);
+
+            // Verify signature on hash
+            bool verify(const std::string & digest, const Values & sig, const Values & pub);
+        }
+    }
+}
+
+#endif
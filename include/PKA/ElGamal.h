@@ -26,7 +26,9 @@ THE SOFTWARE.
 #ifndef __ELGAMAL__
 #define __ELGAMAL__
 
+#include "Misc/FixedBase.h"
 #include "Misc/mpi.h"
+#include "NoncePool.h"
 #include "PKA/PKA.h"
 
 namespace OpenPGP {
@@ -35,9 +37,38 @@ namespace OpenPGP {
             // Generate ElGamal key values
             Values keygen(unsigned int bits = 2048);
 
+            // Precompute powers of g for encrypting with the group in pub
+            FixedBase::Ptr precompute(const PKA::Values & pub);
+
             // Encrypt data
-            Values encrypt(const MPI & data, const PKA::Values & pub);
-            Values encrypt(const std::string & data, const PKA::Values & pub);
+            //
+            // If g_table is given, it must have been made by
+            // precompute() with the same p and g.
+            Values encrypt(const MPI & data, const PKA::Values & pub, const FixedBase::Ptr & g_table = nullptr);
+            Values encrypt(const std::string & data, const PKA::Values & pub, const FixedBase::Ptr & g_table = nullptr);
+
+            // Message independent half of an encryption
+            struct Nonce {
+                MPI r;      // g^k mod p
+                MPI s;      // y^k mod p
+            };
+
+            // Pool of nonces for one public key
+            typedef NoncePool <Nonce> Pool;
+
+            // zero a nonce that will not be used
+            void wipe(Nonce & nonce);
+
+            // fresh nonce for the public key in pub
+            Nonce nonce(const PKA::Values & pub, const FixedBase::Ptr & g_table = nullptr);
+
+            // Online encryption step: {r, m * s mod p}
+            //
+            // Each nonce must only be used once. The Pool overloads
+            // take a new nonce for every encryption.
+            Values encrypt(const MPI & data, const PKA::Values & pub, const Nonce & nonce);
+            Values encrypt(const MPI & data, const PKA::Values & pub, Pool & pool);
+            Values encrypt(const std::string & data, const PKA::Values & pub, Pool & pool);
 
             // Decrypt data
             std::string decrypt(const PKA::Values & c, const PKA::Values & pri, const PKA::Values & pub);
@@ -0,0 +1,174 @@
+/*
+NoncePool.h
+Background precomputation of per-operation secret values
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __NONCE_POOL__
+#define __NONCE_POOL__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace OpenPGP {
+    namespace PKA {
+
+        // values without their own wipe() are left as they are
+        template <typename T>
+        void wipe(T &) {}
+
+        // Queue of message independent values (DSA (k^-1, r) pairs,
+        // ElGamal (g^k, y^k) pairs) that a background thread keeps
+        // filled, so that the online step only has to combine one
+        // of them with the message
+        //
+        // Every value is handed out exactly once. When the queue drops
+        // below low (at least 1), the thread refills it up to capacity.
+        // take() never waits on the thread: if the queue is empty, it
+        // generates a value itself. If the generator throws on the
+        // thread, filling stops and take() rethrows the exception once
+        // the values already made run out.
+        //
+        // Values still queued when the pool is destroyed are passed to
+        // wipe(T &), found by argument dependent lookup.
+        template <typename T>
+        class NoncePool {
+            public:
+                typedef std::function <T ()> Generator;
+
+            private:
+                const Generator generate;
+                const std::size_t capacity;
+                const std::size_t low;
+
+                std::deque <T> values;
+                mutable std::mutex mutex;
+                std::condition_variable wake;
+                bool stopping;
+                std::exception_ptr failure;         // thrown by generate() on the thread
+                std::thread filler;
+
+                void fill() {
+                    std::unique_lock <std::mutex> lock(mutex);
+                    while (true) {
+                        wake.wait(lock, [this]{ return stopping || (values.size() < low); });
+
+                        while (!stopping && (values.size() < capacity)) {
+                            lock.unlock();
+                            try {
+                                T value = generate();
+                                lock.lock();
+                                values.push_back(std::move(value));
+                            }
+                            catch (...) {
+                                if (!lock.owns_lock()) {
+                                    lock.lock();
+                                }
+                                failure = std::current_exception();
+                                return;
+                            }
+                        }
+
+                        if (stopping) {
+                            return;
+                        }
+                    }
+                }
+
+            public:
+                NoncePool(const Generator & generate, const std::size_t capacity = 64)
+                    : NoncePool(generate, capacity, capacity >> 1)
+                {}
+
+                NoncePool(const Generator & generate, const std::size_t capacity, const std::size_t low)
+                    : generate(generate),
+                      capacity(capacity),
+                      low(low?low:1),
+                      values(),
+                      mutex(),
+                      wake(),
+                      stopping(false),
+                      failure(),
+                      filler()
+                {
+                    if (!generate || !capacity || (low > capacity)) {
+                        throw std::runtime_error("Error: Bad nonce pool configuration.");
+                    }
+
+                    filler = std::thread(&NoncePool::fill, this);
+                }
+
+                NoncePool(const NoncePool & copy) = delete;
+                NoncePool & operator=(const NoncePool & copy) = delete;
+
+                ~NoncePool() {
+                    {
+                        std::lock_guard <std::mutex> lock(mutex);
+                        stopping = true;
+                        for(T & value : values) {
+                            wipe(value);
+                        }
+                        values.clear();
+                    }
+                    wake.notify_one();
+                    filler.join();
+                }
+
+                // remove one value, or generate one if none are ready
+                T take() {
+                    {
+                        std::lock_guard <std::mutex> lock(mutex);
+                        if (!values.empty()) {
+                            T value = std::move(values.front());
+                            values.pop_front();
+                            if (values.size() < low) {
+                                wake.notify_one();
+                            }
+                            return value;
+                        }
+
+                        if (failure) {
+                            std::rethrow_exception(failure);
+                        }
+                    }
+
+                    wake.notify_one();
+                    return generate();
+                }
+
+                // number of values ready
+                std::size_t size() const {
+                    std::lock_guard <std::mutex> lock(mutex);
+                    return values.size();
+                }
+        };
+    }
+}
+
+#endif
@@ -29,6 +29,9 @@ THE SOFTWARE.
 #include <map>
 
 #include "PKA/DSA.h"
+#include "PKA/ECDH.h"
+#include "PKA/ECDSA.h"
+#include "PKA/EdDSA.h"
 #include "PKA/ElGamal.h"
 #include "PKA/PKA.h"
 #include "PKA/RSA.h"
@@ -171,7 +174,7 @@ namespace OpenPGP {
             params:
                 DSA = {L, N}
                 ELGAMAL = {bits}
-                RSA = {bits}
+                RSA = {bits, e}
 
             pub and pri are destination containers
         */
@@ -30,24 +30,59 @@ THE SOFTWARE.
 #include "common/includes.h"
 #include "Misc/mpi.h"
 #include "Misc/pgptime.h"
+#include "Misc/prime.h"
 #include "PKA.h"
 
 namespace OpenPGP {
     namespace PKA {
         namespace RSA {
             // Generate RSA key values
-            Values keygen(const uint32_t & bits = 2048);
+            //
+            // bits is the size of each prime. e defaults to 65537 so
+            // that encryption and verification are cheap; primes are
+            // regenerated until e is invertible mod (p - 1)(q - 1).
+            Values keygen(const uint32_t & bits = 2048, const MPI & e = 65537);
 
             // Encrypt data
             MPI encrypt(const MPI & data, const Values & pub);
             MPI encrypt(const std::string & data, const Values & pub);
 
+            // Private key in Chinese Remainder Theorem form
+            //
+            // OpenPGP secret keys carry {d, p, q, u} with p < q and
+            // u = p^-1 mod q. dP and dQ are not stored in the packet,
+            // so callers that reuse a key should precompute them once.
+            struct CRT {
+                MPI p, q;       // primes
+                MPI dP, dQ;     // d mod (p - 1), d mod (q - 1)
+                MPI u;          // p^-1 mod q
+
+                CRT();
+
+                // derive dP and dQ; pri must satisfy has_crt
+                explicit CRT(const Values & pri);
+            };
+
+            // whether or not pri has usable {d, p, q, u} for the modulus in pub
+            // a wrong u would make CRT results wrong mod q, which leaks q
+            bool has_crt(const Values & pri, const Values & pub);
+
             // Decrypt data
-            MPI decrypt(const MPI & data, const Values & pri, const Values & pub);
+            //
+            // Uses CRT when pri has p, q, and u, and falls back to
+            // data^d mod n when only d is present. With fault_check,
+            // the result is verified with the public exponent before
+            // being returned, so a faulty CRT half cannot leak p or q.
+            MPI decrypt(const MPI & data, const Values & pri, const Values & pub, const bool fault_check = false);
+            MPI decrypt(const MPI & data, const CRT & pri, const Values & pub, const bool fault_check = false);
 
             // Sign data
-            MPI sign(const MPI & data, const Values & pri, const Values & pub);
-            MPI sign(const std::string & data, const Values & pri, const Values & pub);
+            //
+            // Signatures are published, so they are checked against the
+            // public key before being returned unless fault_check is off.
+            MPI sign(const MPI & data, const Values & pri, const Values & pub, const bool fault_check = true);
+            MPI sign(const MPI & data, const CRT & pri, const Values & pub, const bool fault_check = true);
+            MPI sign(const std::string & data, const Values & pri, const Values & pub, const bool fault_check = true);
 
             // Verify signature
             bool verify(const MPI & data, const Values & signature, const Values & pub);
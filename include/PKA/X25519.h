@@ -1,6 +1,6 @@
 /*
-MD5.h
-MD5 hashing algorithm
+X25519.h
+Diffie-Hellman function over Curve25519 (RFC 7748)
 
 Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
 
@@ -23,27 +23,24 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
-#ifndef __OPENSSL_MD5__
-#define __OPENSSL_MD5__
+#ifndef __X25519__
+#define __X25519__
 
-#include <openssl/md5.h>
-
-#include "Hashes/MerkleDamgard.h"
+#include <cstddef>
+#include <string>
 
 namespace OpenPGP {
-    namespace Hash {
-        class MD5 : public MerkleDamgard {
-            private:
-                MD5_CTX ctx;
-
-            public:
-                MD5();
-                MD5(const std::string & data);
-                void update(const std::string & data);
-                std::string hexdigest();
-                std::size_t blocksize() const;
-                std::size_t digestsize() const;
-        };
+    namespace PKA {
+        namespace X25519 {
+            // scalars and u-coordinates are 32 octets, little endian
+            const std::size_t SIZE = 32;
+
+            // k * u, with k clamped as RFC 7748 sec 5 describes
+            std::string scalarmult(const std::string & k, const std::string & u);
+
+            // k * 9
+            std::string public_key(const std::string & k);
+        }
     }
 }
 
@@ -27,11 +27,13 @@ THE SOFTWARE.
 #define __PARTIAL__
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "Packets/Packet.h"
 #include "Packets/PartialBodyLengthEnums.h"
+#include "common/Output.h"
 
 namespace OpenPGP {
     namespace Packet {
@@ -105,6 +107,78 @@ namespace OpenPGP {
 
                 Partial & operator=(const Partial &copy);
         };
+
+        // Writes the body of one new format packet as it arrives, as
+        // partial body lengths of 2^chunk_bits octets followed by a
+        // final normal length
+        //
+        // At most one chunk is buffered. A body that ends before the
+        // first chunk is full is written with a normal length.
+        class PartialWriter {
+            private:
+                Output out;
+                uint8_t tag;
+                uint8_t bits;
+                std::size_t chunk;
+                std::string buffer;
+                bool started;                   // whether or not the packet header was written
+                bool finished;
+
+            public:
+                static const uint8_t DEFAULT_CHUNK_BITS = 16;
+
+                // chunk_bits is 9 (512 octets, the smallest first partial length) to 30
+                PartialWriter(const Output & output, const uint8_t tag, const uint8_t chunk_bits = DEFAULT_CHUNK_BITS);
+                PartialWriter(const PartialWriter & copy) = delete;
+                PartialWriter & operator=(const PartialWriter & copy) = delete;
+
+                void write(const std::string & data);
+                void finish();
+        };
+
+        // Splits a stream of packets given in pieces of any size into
+        // packet bodies, following old and new format headers and
+        // partial body lengths
+        //
+        // Bodies are handed to the handler as they arrive. The final
+        // piece of each packet has last set, and may be empty. Malformed
+        // headers throw std::runtime_error.
+        class PacketReader {
+            public:
+                typedef std::function <void (const uint8_t tag, const std::string & data, const bool last)> Handler;
+
+            private:
+                enum State {
+                    HEADER,                     // expecting a packet tag
+                    LENGTH,                     // reading a length header
+                    BODY,                       // reading a known number of octets
+                    REST,                       // old format packet of indeterminate length
+                };
+
+                Handler handler;
+                State state;
+                uint8_t tag;
+                bool new_format;
+                uint8_t old_octets;             // length octets of an old format header
+                std::string length;             // length header octets read so far
+                uint64_t remaining;             // octets left in the current body part
+                bool partial;                   // whether or not more body parts follow
+
+                bool read_length();             // true once the length header is complete
+
+            public:
+                PacketReader(const Handler & handler);
+                PacketReader(const PacketReader & copy) = delete;
+                PacketReader & operator=(const PacketReader & copy) = delete;
+
+                void update(const std::string & data);
+
+                // throws if the data ended inside a packet
+                void finish();
+
+                // whether or not the data so far ended on a packet boundary
+                bool idle() const;
+        };
     }
 }
 
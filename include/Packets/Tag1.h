@@ -73,6 +73,13 @@ namespace OpenPGP {
         //
         //      - MPI of ELGAMAL (Diffie-Hellman) value m * y**k mod p.
         //
+        //    Algorithm Specific Fields for ECDH encryption (RFC 6637 sec 10):
+        //
+        //      - MPI of an EC point representing an ephemeral public key.
+        //
+        //      - a one-octet size, followed by a symmetric key encoded using the
+        //        method described in Section 8.
+        //
         //    The value "m" in the above formulas is derived from the session key
         //    as follows.  First, the session key is prefixed with a one-octet
         //    algorithm identifier that specifies the symmetric encryption
@@ -98,6 +105,7 @@ namespace OpenPGP {
                 std::string keyid;      // 8 octets
                 uint8_t pka;
                 PKA::Values mpi;        // algorithm specific fields
+                std::string wrapped;    // ECDH only: wrapped session key
 
                 void actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length);
                 void show_contents(HumanReadable & hr) const;
@@ -113,10 +121,12 @@ namespace OpenPGP {
                 std::string get_keyid() const;
                 uint8_t get_pka() const;
                 PKA::Values get_mpi() const;
+                std::string get_wrapped() const;
 
                 void set_keyid(const std::string & k);
                 void set_pka(const uint8_t p);
                 void set_mpi(const PKA::Values & m);
+                void set_wrapped(const std::string & w);
 
                 Tag::Ptr clone() const;
         };
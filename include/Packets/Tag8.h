@@ -70,7 +70,16 @@ namespace OpenPGP {
                 friend Message;
 
                 uint8_t comp;
-                std::string compressed_data;
+                int level;                                              // not written; only used when compressing
+                int strategy;
+
+                // both representations are kept; whichever one is missing
+                // is produced from the other on first use and dropped when
+                // the other one changes
+                mutable std::string compressed_data;
+                mutable std::string data;
+                mutable bool have_compressed;
+                mutable bool have_data;
 
                 // call external functions to do compression and decompression
                 std::string compress(const std::string & data) const;
@@ -91,11 +100,17 @@ namespace OpenPGP {
                 std::string write(Status * status = nullptr, const bool check_mpi = false) const;
 
                 uint8_t get_comp() const;
+                int get_level() const;
+                int get_strategy() const;
                 std::string get_data() const;                           // get uncompressed data
+                Status get_data(const Compression::Sink & sink,         // stream uncompressed data without keeping it
+                                const Compression::Budget & budget) const;
                 Message get_body() const;                               // get parsed uncompressed data
                 std::string get_compressed_data() const;                // get compressed data
 
                 void set_comp(const uint8_t alg);
+                void set_level(const int l);                            // zlib level or bzip2 block size
+                void set_strategy(const int s);                         // zlib strategy
                 void set_data(const std::string & data);                // set uncompressed data
                 void set_body(const Message & msg);                     // set parsed uncompressed data
                 void set_compressed_data(const std::string & data);     // set compressed data
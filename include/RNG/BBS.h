@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __BBS__
 #define __BBS__
 
+#include <mutex>
 #include <string>
 
 #include "Misc/mpi.h"
@@ -41,6 +42,7 @@ namespace OpenPGP {
                 static bool seeded;               // whether or not BBS is seeded
                 static MPI state;                 // current state
                 static MPI m;                     // large integer
+                static std::mutex mutex;          // guards the shared state
                 const static MPI two;             // constant value of 2
                 std::string par;                  // even, odd, or least
 
@@ -51,6 +53,7 @@ namespace OpenPGP {
             public:
                 BBS(...);
                 BBS(const MPI & SEED, const unsigned int & bits = 1024, MPI p = 0, MPI q = 0);
+                void fill(void * buf, const std::size_t len, const std::string & par = "even");
                 std::string rand_bits (const unsigned int & bits  = 1, const std::string & par = "even");
                 std::string rand_bytes(const unsigned int & bytes = 1, const std::string & par = "even");
         };
@@ -0,0 +1,66 @@
+/*
+ChaCha20.h
+ChaCha20 based deterministic random bit generator
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __CHACHA20_RNG__
+#define __CHACHA20_RNG__
+
+#include <cstdint>
+#include <string>
+
+namespace OpenPGP {
+    namespace RNG {
+        /*
+        ChaCha20 (RFC 8439) keystream generator with fast key erasure:
+        every refill runs the cipher under the current key, keeps all but
+        the first 32 octets, and replaces the key with those 32 octets, so
+        earlier output can not be recovered from the state.
+
+        Every thread has its own generator, so callers never contend for
+        it. Requests up to BUFFER_SIZE octets are served from a per-thread
+        buffer of keystream, which is wiped as it is handed out.
+
+        A thread's key is seeded from the operating system (getrandom(2),
+        or /dev/urandom where that is not available) on first use, and
+        reseeded after RESEED_INTERVAL octets of output and in the child
+        after fork().
+        */
+        class ChaCha20{
+            public:
+                static const uint64_t RESEED_INTERVAL = 1 << 20;
+                static const std::size_t BUFFER_SIZE = 1024 - 32;
+
+                // one 64 octet keystream block (RFC 8439 sec 2.3)
+                static std::string block(const std::string & key, const uint32_t counter, const std::string & nonce);
+
+                ChaCha20();
+                ChaCha20(const std::string & seed);   // mixes additional entropy into this thread's generator
+                void fill(void * buf, const std::size_t len);
+                std::string rand_bits (const unsigned int & bits  = 1);
+                std::string rand_bytes(const unsigned int & bytes = 1);
+        };
+    }
+}
+
+#endif
@@ -41,6 +41,7 @@ namespace OpenPGP {
                 RAND_bytes(...);
                 RAND_bytes(const std::string & seed);
                 RAND_bytes(const void * buf, int num);
+                void fill(void * buf, const std::size_t len, const std::size_t max_attempts = 5);
                 std::string rand_bits (const unsigned int & bits  = 1, const std::size_t max_attempts = 5);
                 std::string rand_bytes(const unsigned int & bytes = 1, const std::size_t max_attempts = 5);
         };
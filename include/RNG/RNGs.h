@@ -34,13 +34,33 @@ namespace OpenPGP {
     }
 }
 
-#else
+#elif defined(BBS_RNG)
 #include "BBS.h"
 namespace OpenPGP {
     namespace RNG {
         typedef BBS RNG;
     }
 }
+
+#else
+#include "ChaCha20.h"
+namespace OpenPGP {
+    namespace RNG {
+        typedef ChaCha20 RNG;
+    }
+}
 #endif
 
+#include "Misc/mpi.h"
+
+namespace OpenPGP {
+    namespace RNG {
+        // uniformly random integer in [0, 2^bits)
+        MPI rand_mpi(const unsigned int bits);
+
+        // uniformly random integer in [1, q), for q > 1
+        MPI rand_range(const MPI & q);
+    }
+}
+
 #endif
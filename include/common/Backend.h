@@ -0,0 +1,65 @@
+/*
+Backend.h
+Runtime selection of the cryptographic backend
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_BACKEND__
+#define __OPENPGP_BACKEND__
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace OpenPGP {
+    namespace Backend {
+
+        // Implementations used for hashing and symmetric encryption
+        //
+        // The built-in implementations are always available. The
+        // OpenSSL EVP backend is available when the library was
+        // built with USE_OPENSSL_HASH and/or USE_OPENSSL_SYM, and
+        // is selected by default when present. Algorithms that
+        // EVP does not provide fall back to the built-in code.
+
+        namespace ID {
+            constexpr uint8_t BUILTIN       = 0;
+            constexpr uint8_t OPENSSL       = 1;
+        }
+
+        const std::map <uint8_t, std::string> NAME = {
+            std::make_pair(ID::BUILTIN,     "Built-in"),
+            std::make_pair(ID::OPENSSL,     "OpenSSL EVP"),
+        };
+
+        // whether or not the backend was compiled in
+        bool available(const uint8_t backend);
+
+        // select the backend; returns false if it is not available
+        bool set(const uint8_t backend);
+
+        // currently selected backend
+        uint8_t get();
+    }
+}
+
+#endif
@@ -1,6 +1,6 @@
 /*
-SHA224.h
-The SHA2 algorithm SHA-224
+Input.h
+Sources of streamed input
 
 Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
 
@@ -23,28 +23,32 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
-#ifndef __OPENSSL_SHA224__
-#define __OPENSSL_SHA224__
+#ifndef __OPENPGP_INPUT__
+#define __OPENPGP_INPUT__
 
-#include <openssl/sha.h>
-
-#include "Hashes/MerkleDamgard.h"
+#include <cstddef>
+#include <functional>
+#include <string>
 
 namespace OpenPGP {
-    namespace Hash {
-        class SHA224 : public MerkleDamgard {
-            protected:
-                SHA256_CTX ctx;
-
-            public:
-                SHA224();
-                SHA224(const std::string & data);
-                void update(const std::string & str);
-                virtual std::string hexdigest();
-                virtual std::size_t blocksize() const;
-                virtual std::size_t digestsize() const;
-        };
-    }
+
+    // receives streamed input in order, one piece at a time
+    //
+    // data is only valid until the call returns
+    typedef std::function <void (const char * data, const std::size_t len)> Input;
+
+    // pass everything in fd, from its start if it is seekable, to input
+    //
+    // Regular files are mapped with mmap(2) and advised MADV_SEQUENTIAL.
+    // Anything else is read with pread(2) (or read(2) if fd cannot seek)
+    // into two buffers, so the next piece is read while input handles the
+    // current one. The file must not be truncated while it is being read.
+    // Throws if reading fails.
+    void from_fd(const int fd, const Input & input);
+
+    // from_fd on filename opened read only; throws if it cannot be opened
+    void from_file(const std::string & filename, const Input & input);
+
 }
 
 #endif
@@ -1,6 +1,6 @@
 /*
-SHA1.h
-Secure Hash Algorithm 1
+Output.h
+Destinations for streamed output
 
 Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
 
@@ -23,28 +23,24 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
-#ifndef __OPENSSL_SHA1__
-#define __OPENSSL_SHA1__
+#ifndef __OPENPGP_OUTPUT__
+#define __OPENPGP_OUTPUT__
 
-#include <openssl/sha.h>
-
-#include "Hashes/MerkleDamgard.h"
+#include <functional>
+#include <ostream>
+#include <string>
 
 namespace OpenPGP {
-    namespace Hash {
-        class SHA1 : public MerkleDamgard {
-            protected:
-                SHA_CTX ctx;
-
-            public:
-                SHA1();
-                SHA1(const std::string & data);
-                void update(const std::string & str);
-                virtual std::string hexdigest();
-                virtual std::size_t blocksize() const;
-                virtual std::size_t digestsize() const;
-        };
-    }
+
+    // receives streamed output in order, one piece at a time
+    typedef std::function <void (const std::string &)> Output;
+
+    // write to a stream; throws if the stream fails
+    Output to_stream(std::ostream & stream);
+
+    // write to a file descriptor; throws if write(2) fails
+    Output to_fd(const int fd);
+
 }
 
 #endif
@@ -30,6 +30,9 @@ namespace OpenPGP {
     enum Status {
         SUCCESS,
         INVALID,
+        DECOMPRESSION_OUTPUT_LIMIT,     // Tag 8
+        DECOMPRESSION_RATIO_LIMIT,      // Tag 8
+        INVALID_COMPRESSED_DATA,        // Tag 8
         INVALID_COMPRESSION_ALGORITHM,  // Tag 8, Tag 2 Sub 22
         INVALID_CONTENTS,
         INVALID_FINGERPRINT,
@@ -47,6 +50,7 @@ namespace OpenPGP {
         INVALID_TAG,
         INVALID_VERSION,
         MISSING_S2K,                    // Tag 3, 5
+        MISSING_SESSION_KEY,            // Tag 1, 3
         PKA_CANNOT_BE_USED,
         REGEX_ERROR,                    // Tag 2 Sub 6
         RESERVED,
@@ -0,0 +1,81 @@
+/*
+ThreadPool.h
+Fixed size pool of worker threads
+
+Copyright (c) 2013 - 2019 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __THREAD_POOL__
+#define __THREAD_POOL__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenPGP {
+
+    // Runs submitted tasks on a fixed number of threads
+    //
+    // The destructor runs every task that was already submitted
+    // before joining the threads. If a task throws, the first
+    // exception is rethrown by wait().
+    class ThreadPool {
+        public:
+            typedef std::function <void ()> Task;
+
+        private:
+            std::vector <std::thread> workers;
+            std::deque <Task> tasks;
+            std::mutex mutex;
+            std::condition_variable available;  // signaled when a task is queued or on shutdown
+            std::condition_variable idle;       // signaled when a task finishes
+            std::size_t running;
+            bool stopping;
+            std::exception_ptr error;
+
+            void work();
+
+        public:
+            // 0 threads means one per hardware thread
+            explicit ThreadPool(std::size_t threads = 0);
+            ThreadPool(const ThreadPool & copy) = delete;
+            ThreadPool & operator=(const ThreadPool & copy) = delete;
+            ~ThreadPool();
+
+            std::size_t size() const;
+
+            // whether or not the caller is running on one of this pool's threads
+            bool in_worker() const;
+
+            void submit(const Task & task);
+
+            // block until every submitted task has finished
+            void wait();
+    };
+
+}
+
+#endif
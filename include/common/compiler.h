@@ -19,4 +19,12 @@
 
 #endif
 
+namespace OpenPGP {
+
+    // 128 bit unsigned integer for products of 64 bit limbs (GCC and clang);
+    // __extension__ keeps -Wpedantic quiet about the non-standard type
+    __extension__ typedef unsigned __int128 uint128_t;
+
+}
+
 #endif // __COMPILER_H__
@@ -38,6 +38,9 @@ THE SOFTWARE.
 #include "Misc/mpi.h"
 #include "PKA/PKAs.h"
 #include "Packets/Packets.h"
+#include "Packets/Partial.h"
+#include "common/Output.h"
+#include "common/Status.h"
 #include "verify.h"
 
 namespace OpenPGP {
@@ -57,6 +60,69 @@ namespace OpenPGP {
         Message sym(const Message & message,
                     const std::string & passphrase);
 
+        // Streaming decryption
+        //
+        // A binary message is given in pieces of any size. The session key
+        // is taken from the session key packets in front of the encrypted
+        // data, which is then decrypted, checked against its MDC,
+        // decompressed, and unwrapped as it arrives. Only the contents of
+        // Literal Data Packets are written to output.
+        //
+        // Output is written before the MDC can be checked. It must not be
+        // trusted unless finish() returns SUCCESS. Once a call fails,
+        // every later call returns the same Status.
+        class Stream {
+            private:
+                SecretKey::Ptr pri;                 // nullptr when decrypting with a passphrase
+                std::string passphrase;
+                Output out;
+                Compression::Budget budget;
+                Status status;
+                Packet::PacketReader reader;
+
+                std::string packet;                 // body of the current session key packet
+                uint8_t sym;
+                std::string session_key;
+
+                uint8_t encrypted;                  // tag of the encrypted data packet, once seen
+                std::string head;                   // octets in front of the CFB data
+                std::shared_ptr <CFB> cfb;
+                Hash::Instance mdc;
+                std::size_t prefix;                 // octets of decrypted prefix left to skip
+                std::string tail;                   // decrypted octets that might be the MDC packet
+                std::shared_ptr <MessageReader> contents;
+                bool done;                          // whether or not the encrypted data ended
+
+                void read_packet(const uint8_t tag, const std::string & data, const bool last);
+                void read_session_key(const uint8_t tag);
+                void read_encrypted(const std::string & data, const bool last);
+                void read_plaintext(const std::string & data);
+
+            public:
+                // session key encrypted with public key algorithm
+                Stream(const SecretKey & pri,
+                       const std::string & passphrase,
+                       const Output & output,
+                       const Compression::Budget & budget = Compression::Budget());
+
+                // session key encrypted with symmetric algorithm
+                Stream(const std::string & passphrase,
+                       const Output & output,
+                       const Compression::Budget & budget = Compression::Budget());
+
+                Stream(const Stream & copy) = delete;
+                Stream & operator=(const Stream & copy) = delete;
+
+                Status update(const std::string & data);
+
+                // SUCCESS only if all of the encrypted data was read and,
+                // for Tag 18, the MDC matched
+                Status finish();
+
+                // update() with everything left in stream, then finish()
+                Status read(std::istream & stream);
+        };
+
 }
 }
 
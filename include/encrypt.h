@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <string>
 
 #include "Compress/Compress.h"
+#include "Compress/Policy.h"
 #include "Encryptions/Encryptions.h"
 #include "Hashes/Hashes.h"
 #include "Key.h"
@@ -36,6 +37,8 @@ THE SOFTWARE.
 #include "Misc/PKCS1.h"
 #include "Misc/cfb.h"
 #include "PKA/PKAs.h"
+#include "Packets/Partial.h"
+#include "common/Output.h"
 #include "revoke.h"
 #include "sign.h"
 
@@ -50,6 +53,9 @@ namespace OpenPGP {
             SecretKey::Ptr signer;          // for signing data
             std::string passphrase;         // only used when signer is present
             uint8_t hash;                   // hash used to sign data
+            int level;                      // compression level, or Compression::LEVEL_AUTO to sample the data
+            int strategy;                   // zlib compression strategy
+            Compression::Observer observer; // called with the compression decision, if set
 
             Args(const std::string & fname = "",
                  const std::string & dat = "",
@@ -58,7 +64,10 @@ namespace OpenPGP {
                  const bool mod_detect = true,
                  const SecretKey::Ptr & signing_key = nullptr,
                  const std::string & pass = "",
-                 const uint8_t hash_alg = Hash::ID::SHA1)
+                 const uint8_t hash_alg = Hash::ID::SHA1,
+                 const int comp_level = Compression::LEVEL_AUTO,
+                 const int comp_strategy = Z_DEFAULT_STRATEGY,
+                 const Compression::Observer & comp_observer = nullptr)
                 : filename(fname),
                   data(dat),
                   sym(sym_alg),
@@ -66,7 +75,10 @@ namespace OpenPGP {
                   mdc(mod_detect),
                   signer(signing_key),
                   passphrase(pass),
-                  hash(hash_alg)
+                  hash(hash_alg),
+                  level(comp_level),
+                  strategy(comp_strategy),
+                  observer(comp_observer)
             {}
 
             bool valid() const{
@@ -80,6 +92,16 @@ namespace OpenPGP {
                     return false;
                 }
 
+                if ((level != Compression::LEVEL_AUTO) && ((level < Z_DEFAULT_COMPRESSION) || (9 < level))){
+                    // "Error: Bad Compression Level: " + std::to_string(level);
+                    return false;
+                }
+
+                if ((strategy < Z_DEFAULT_STRATEGY) || (Z_FIXED < strategy)){
+                    // "Error: Bad Compression Strategy: " + std::to_string(strategy);
+                    return false;
+                }
+
                 if (Hash::NAME.find(hash) == Hash::NAME.end()){
                     // "Error: Bad Hash Algorithm: " + std::to_string(hash);
                     return false;
@@ -101,6 +123,49 @@ namespace OpenPGP {
         Message sym(const Args & args,
                     const std::string & passphrase,
                     const uint8_t key_hash);
+
+        // Streaming encryption
+        //
+        // The session key packet is written by the constructor. Data given
+        // to update() is then written as it arrives as new format packets
+        // with partial body lengths:
+        //
+        //     encrypted(compressed(literal(data)) + MDC)
+        //
+        // or, if args.signer is set, with the one pass signed message that
+        // Sign::Stream writes in place of compressed(literal(data)).
+        //
+        // Only the first Compression::POLICY_SAMPLE octets (to pick the
+        // compression) and one chunk per packet layer are held in memory.
+        // Output is binary; args.data is not used. The constructors throw
+        // if the arguments or the key are bad.
+        class Stream {
+            private:
+                Args args;
+                Output out;
+                std::shared_ptr <CFB> cfb;
+                Hash::Instance mdc;
+                Compression::Compressor::Ptr compressor;
+                std::shared_ptr <Packet::PartialWriter> encrypted;
+                std::shared_ptr <Packet::PartialWriter> compressed;
+                std::shared_ptr <Packet::PartialWriter> literal;
+                std::shared_ptr <Sign::Stream> signing;
+                std::string pending;            // data held until compression is decided
+                bool finished;
+
+                void start(const std::string & session_key);
+                void start_literal();
+                void write_plaintext(const std::string & data);
+
+            public:
+                Stream(const Args & args, const Key & pub, const Output & output);
+                Stream(const Args & args, const std::string & passphrase, const uint8_t key_hash, const Output & output);
+                Stream(const Stream & copy) = delete;
+                Stream & operator=(const Stream & copy) = delete;
+
+                void update(const std::string & data);
+                void finish();
+        };
     }
 }
 #endif
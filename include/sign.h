@@ -42,6 +42,8 @@ THE SOFTWARE.
 #include "Misc/sigcalc.h"
 #include "PKA/PKAs.h"
 #include "Packets/Packets.h"
+#include "Packets/Partial.h"
+#include "common/Output.h"
 #include "common/includes.h"
 #include "decrypt.h"
 #include "revoke.h"
@@ -50,7 +52,12 @@ THE SOFTWARE.
 namespace OpenPGP {
     namespace Sign {
         // internal functions
-        PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash);
+        //
+        // curve is the key's curve OID, only used by ECDSA
+        PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash, const std::string & curve = "");
+
+        // sign with a secret key packet, decrypting its secret values
+        PKA::Values with_pka(const std::string & digest, const Packet::Tag5::Ptr & signer, const std::string & passphrase, const uint8_t hash);
 
         // Generates a new signature packet without PKA values
         Packet::Tag2::Ptr create_sig_packet(const uint8_t version, const uint8_t type, const uint8_t pka, const uint8_t hash, const std::string & keyid);
@@ -98,7 +105,40 @@ namespace OpenPGP {
 
         // 0x00: Signature of a binary document.
         // signed file is embedded into output
-        Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress);
+        Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress, const int level = Z_DEFAULT_COMPRESSION, const int strategy = Z_DEFAULT_STRATEGY);
+
+        // 0x00: Signature of a binary document, one pass
+        //
+        // Writes the same packets as binary(): a One-Pass Signature Packet,
+        // the data in a Literal Data Packet with partial body lengths, and
+        // the Signature Packet, all in a Compressed Data Packet if compress
+        // is set. The data is hashed as it is given. Output is binary.
+        // Throws if args are bad or signing fails.
+        class Stream {
+            private:
+                Packet::Tag5::Ptr signer;
+                std::string passphrase;
+                Packet::Tag2::Ptr sig;
+                Hash::Instance hash;
+                Output out;                             // after compression, if any
+                Compression::Compressor::Ptr compressor;
+                std::shared_ptr <Packet::PartialWriter> compressed;
+                std::shared_ptr <Packet::PartialWriter> literal;
+                bool finished;
+
+            public:
+                Stream(const Args & args,
+                       const std::string & filename,
+                       const Output & output,
+                       const uint8_t compress = Compression::ID::UNCOMPRESSED,
+                       const int level = Z_DEFAULT_COMPRESSION,
+                       const int strategy = Z_DEFAULT_STRATEGY);
+                Stream(const Stream & copy) = delete;
+                Stream & operator=(const Stream & copy) = delete;
+
+                void update(const std::string & data);
+                void finish();
+        };
 
         // 0x01: Signature of a canonical text document.
         CleartextSignature cleartext_signature(const Args & args, const std::string & text);
@@ -26,10 +26,14 @@ THE SOFTWARE.
 #ifndef __VERIFY__
 #define __VERIFY__
 
+#include <functional>
+#include <istream>
 #include <string>
+#include <vector>
 
 #include "CleartextSignature.h"
 #include "DetachedSignature.h"
+#include "Hashes/Hashes.h"
 #include "Key.h"
 #include "Message.h"
 #include "Misc/PKCS1.h"
@@ -38,22 +42,135 @@ THE SOFTWARE.
 #include "PKA/PKAs.h"
 #include "Packets/Packets.h"
 #include "RevocationCertificate.h"
+#include "common/Input.h"
+#include "common/Output.h"
+#include "common/Status.h"
+#include "common/ThreadPool.h"
 
 namespace OpenPGP {
     namespace Verify {
         // verify pka with variables only
-        int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee);
+        //
+        // curve is the signer's curve OID, only used by ECDSA
+        int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee, const std::string & curve = "");
 
         // verify pka with packets
         int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee);
+
+        // One signature check for batch()
+        //
+        // digest is called on a pool thread, so hashing the signed
+        // data is spread across threads along with the PKA work.
+        struct Job {
+            Packet::Key::Ptr signer;
+            Packet::Tag2::Ptr signature;
+            std::function <std::string ()> digest;
+
+            Job();
+            Job(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signature, const std::function <std::string ()> & digest);
+
+            // signature over an already computed digest
+            Job(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signature, const std::string & digest);
+
+            // 0x10 - 0x13 certification of signee_key and signee_id
+            Job(const Packet::Key::Ptr & signer, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signature);
+        };
+
+        // Verify many signatures at once
+        //
+        // Returns one status per job in input order, using the same
+        // values as with_pka: true, false, or -1 on error (including
+        // missing packets and exceptions thrown by a job). When called
+        // from one of pool's own threads, the jobs run on that thread.
+        std::vector <int> batch(const std::vector <Job> & jobs, ThreadPool & pool);
+        std::vector <int> batch(const std::vector <Job> & jobs, const std::size_t threads = 0);
         // /////////////////
 
         // detached signatures (not a standalone signature)
         int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig);
 
+        // detached signatures over everything in a file, hashed as it is
+        // read with from_fd, so the file is never held in memory; -1 if
+        // it cannot be read
+        int detached_signature(const Key & key, const int fd, const DetachedSignature & sig);
+        int detached_signature_file(const Key & key, const std::string & filename, const DetachedSignature & sig);
+
         // 0x00: Signature of a binary document.
         int binary(const Key & key, const Message & message);
 
+        // 0x00: Signature of a binary document, one pass
+        //
+        // A binary signed message is given in pieces of any size. The
+        // hash of each One-Pass Signature Packet is set up when the
+        // packet arrives, the literal data is hashed (and written to
+        // output, if set) as it arrives, and each Signature Packet is
+        // checked against the One-Pass Signature Packet it closes. A
+        // Signature Packet in front of the message is checked at the
+        // end. Compressed Data Packets are read in place.
+        //
+        // Nested One-Pass Signature Packets are bracketed as in binary(),
+        // but every signature is taken to be over the literal data, which
+        // is how GnuPG writes them. Signatures over inner Signature
+        // Packets are not supported.
+        //
+        // Output is written before any signature is checked. It must not
+        // be trusted unless finish() returns SUCCESS and verified()
+        // returns true. Once a call fails, every later call returns the
+        // same Status.
+        class Stream {
+            public:
+                struct Result {
+                    Packet::Tag2::Ptr signature;
+                    int status;                     // same values as with_pka
+                };
+
+            private:
+                struct Pending {
+                    Packet::Tag2::Ptr signature;    // nullptr until the Signature Packet arrives
+                    uint8_t hash;
+                    Hash::Instance instance;
+                };
+
+                Packet::Key::Ptr signing_key;
+                Output out;
+                Status status;
+                std::string packet;                 // body of the current signature packet
+                std::vector <Pending> one_pass;     // innermost last
+                std::vector <Pending> leading;      // Signature Packets in front of the message
+                bool closing;                       // whether or not a Signature Packet closed a One-Pass Signature Packet
+                bool finished;
+                std::vector <Result> results;
+                MessageReader reader;
+
+                void read_packet(const uint8_t tag, const std::string & data, const bool last);
+                void read_literal(const std::string & data);
+                int check(const Pending & pending) const;
+
+            public:
+                // throws if key does not have a signing key
+                Stream(const Key & key,
+                       const Output & output = nullptr,
+                       const Compression::Budget & budget = Compression::Budget());
+                Stream(const Stream & copy) = delete;
+                Stream & operator=(const Stream & copy) = delete;
+
+                Status update(const std::string & data);
+
+                // checks the signatures; INVALID if a One-Pass Signature
+                // Packet was not closed by a Signature Packet
+                Status finish();
+
+                // update() with everything left in stream, then finish()
+                Status read(std::istream & stream);
+
+                // one result per Signature Packet, in the order they were checked
+                const std::vector <Result> & get_results() const;
+
+                // as binary(): true if a signature by key verified,
+                // -1 on error, and false otherwise
+                int verified() const;
+        };
+
         // 0x01: Signature of a canonical text document.
         int cleartext_signature(const Key & pub, const CleartextSignature & message);
 
@@ -1,70 +1,239 @@
 #include "Compress/Compress.h"
 
 #include <stdexcept>
+#include <thread>
 
 namespace OpenPGP {
 namespace Compression {
 
+namespace {
+
+class PassCompressor : public Compressor {
+    public:
+        std::string update(const std::string & data) {
+            return data;
+        }
+
+        std::string finish() {
+            return "";
+        }
+};
+
+class PassDecompressor : public Decompressor {
+    public:
+        bool feed(const std::string & data, const Sink & sink) {
+            for(std::string::size_type i = 0; i < data.size(); i += ZLIB_CHUNK) {
+                if (!sink(data.substr(i, ZLIB_CHUNK))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::string finish() {
+            return "";
+        }
+
+        bool done() const {
+            return true;
+        }
+};
+
+}
+
 bool valid(const uint8_t comp) {
     return (NAME.find(comp) != NAME.end());
 }
 
-std::string compress(const uint8_t alg, const std::string & src) {
+Compressor::Ptr compressor(const uint8_t alg, const int level, const int strategy) {
+    switch (alg) {
+        case ID::UNCOMPRESSED:
+            return std::make_shared <PassCompressor> ();
+        case ID::ZIP:
+            return std::make_shared <ZlibCompressor> (DEFLATE_WINDOWBITS, level, strategy);
+        case ID::ZLIB:
+            return std::make_shared <ZlibCompressor> (ZLIB_WINDOWBITS, level, strategy);
+        case ID::BZIP2:
+            return std::make_shared <Bz2Compressor> (((1 <= level) && (level <= 9))?level:bz2_BLOCKSIZE100K);
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown or undefined compression algorithm value: " + std::to_string(alg));
+}
+
+Decompressor::Ptr decompressor(const uint8_t alg) {
+    switch (alg) {
+        case ID::UNCOMPRESSED:
+            return std::make_shared <PassDecompressor> ();
+        case ID::ZIP:
+            return std::make_shared <ZlibDecompressor> (DEFLATE_WINDOWBITS);
+        case ID::ZLIB:
+            return std::make_shared <ZlibDecompressor> (ZLIB_WINDOWBITS);
+        case ID::BZIP2:
+            return std::make_shared <Bz2Decompressor> ();
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown Compression Algorithm value: " + std::to_string(alg));
+}
+
+std::string compress(const uint8_t alg, const std::string & src, const int level, const int strategy) {
     if ((alg != ID::UNCOMPRESSED) && src.size()) { // if the algorithm value is not zero and there is data
-        bool good = false;
-        std::string dst;
-
-        switch (alg) {
-            case ID::ZIP:
-                good = (zlib_compress(src, dst, DEFLATE_WINDOWBITS, Z_DEFAULT_COMPRESSION) == Z_OK);
-                break;
-            case ID::ZLIB:
-                good = (zlib_compress(src, dst, ZLIB_WINDOWBITS, Z_DEFAULT_COMPRESSION) == Z_OK);
-                break;
-            case ID::BZIP2:
-                good = (bz2_compress(src, dst) == BZ_OK);
-                break;
-            default:
-                throw std::runtime_error("Error: Unknown or undefined compression algorithm value: " + std::to_string(alg));
-                break;
+        // split large inputs across cores
+        if (((alg == ID::ZIP) || (alg == ID::ZLIB)) &&
+            (src.size() >= 2 * ZLIB_PARALLEL_BLOCK) &&
+            (std::thread::hardware_concurrency() > 1)) {
+            std::string dst;
+            if (zlib_compress_parallel(src, dst, (alg == ID::ZIP)?DEFLATE_WINDOWBITS:ZLIB_WINDOWBITS, level, strategy) != Z_OK) {
+                throw std::runtime_error("Error: Compression failed");
+            }
+            return dst;
         }
 
-        if (!good) {
-            throw std::runtime_error("Error: Compression failed");
+        if ((alg == ID::BZIP2) && (std::thread::hardware_concurrency() > 1)) {
+            std::string dst;
+            if (bz2_compress_parallel(src, dst, ((1 <= level) && (level <= 9))?level:bz2_BLOCKSIZE100K) != BZ_OK) {
+                throw std::runtime_error("Error: Compression failed");
+            }
+            return dst;
         }
 
-        return dst;
+        Compressor::Ptr c = compressor(alg, level, strategy);
+        try {
+            std::string dst = c -> update(src);
+            dst += c -> finish();
+            return dst;
+        }
+        catch (const std::runtime_error &) {
+            throw std::runtime_error("Error: Compression failed");
+        }
     }
     return src; // 0: uncompressed
 }
 
 std::string decompress(const uint8_t alg, const std::string & src) {
     if ((alg != ID::UNCOMPRESSED) && src.size()) { // if the algorithm value is not zero and there is data
-        bool good = false;
-        std::string dst;
-        switch (alg) {
-            case ID::ZIP:
-                good = (zlib_decompress(src, dst, DEFLATE_WINDOWBITS) == Z_OK);
-                break;
-            case ID::ZLIB:
-                good = (zlib_decompress(src, dst, ZLIB_WINDOWBITS) == Z_OK);
-                break;
-            case ID::BZIP2:
-                good = (bz2_decompress(src, dst) == BZ_OK);
-                break;
-            default:
-                throw std::runtime_error("Error: Unknown Compression Algorithm value: " + std::to_string(alg));
-                break;
+        // bzip2 blocks can be decoded independently
+        if ((alg == ID::BZIP2) && (std::thread::hardware_concurrency() > 1)) {
+            std::string dst;
+            if (bz2_decompress_parallel(src, dst) != BZ_OK) {
+                throw std::runtime_error("Error: Decompression failed");
+            }
+            return dst;
         }
 
-        if (!good) {
+        Decompressor::Ptr d = decompressor(alg);
+        try {
+            std::string dst = d -> update(src);
+            dst += d -> finish();
+            return dst;
+        }
+        catch (const std::runtime_error &) {
             throw std::runtime_error("Error: Decompression failed");
         }
-
-        return dst;
     }
     return src; // 0: uncompressed
 }
 
+BudgetedDecompressor::BudgetedDecompressor(const uint8_t alg, const Budget & limits)
+    : stream(decompressor(alg)),
+      budget(limits),
+      outermost(std::make_shared <std::size_t> (0)),
+      nested(false),
+      consumed(0),
+      produced(0),
+      status(Status::SUCCESS)
+{}
+
+BudgetedDecompressor::BudgetedDecompressor(const uint8_t alg, const BudgetedDecompressor & outer)
+    : stream(decompressor(alg)),
+      budget(outer.budget),
+      outermost(outer.outermost),
+      nested(true),
+      consumed(0),
+      produced(0),
+      status(Status::SUCCESS)
+{}
+
+Status BudgetedDecompressor::feed(const std::string & data, const Sink & sink) {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    consumed += data.size();
+    if (!nested) {
+        *outermost += data.size();
+    }
+
+    try {
+        const bool done = stream -> feed(data, [&](const std::string & piece) {
+            produced += piece.size();
+            if (budget.max_output && (produced > budget.max_output)) {
+                status = Status::DECOMPRESSION_OUTPUT_LIMIT;
+                return false;
+            }
+
+            if ((budget.max_ratio > 0) && (produced > RATIO_GRACE) && (produced > budget.max_ratio * *outermost)) {
+                status = Status::DECOMPRESSION_RATIO_LIMIT;
+                return false;
+            }
+
+            if (!sink(piece)) {
+                status = Status::INVALID;
+                return false;
+            }
+
+            return true;
+        });
+
+        if (!done && (status == Status::SUCCESS)) {
+            status = Status::INVALID;
+        }
+    }
+    catch (const std::runtime_error &) {
+        status = Status::INVALID_COMPRESSED_DATA;
+    }
+
+    return status;
+}
+
+Status BudgetedDecompressor::finish() {
+    if ((status == Status::SUCCESS) && !stream -> done()) {
+        status = Status::INVALID_COMPRESSED_DATA;
+    }
+
+    return status;
+}
+
+std::size_t BudgetedDecompressor::get_consumed() const {
+    return consumed;
+}
+
+std::size_t BudgetedDecompressor::get_produced() const {
+    return produced;
+}
+
+Status decompress(const uint8_t alg, const std::string & data, const Sink & sink, const Budget & budget) {
+    if (!valid(alg) || (alg > ID::BZIP2)) {
+        return Status::INVALID_COMPRESSION_ALGORITHM;
+    }
+
+    // uncompressed and empty data are passed through, as in decompress() above
+    if ((alg == ID::UNCOMPRESSED) || data.empty()) {
+        BudgetedDecompressor passthrough(ID::UNCOMPRESSED, budget);
+        return passthrough.feed(data, sink);
+    }
+
+    BudgetedDecompressor d(alg, budget);
+    const Status status = d.feed(data, sink);
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    return d.finish();
+}
+
 }
 }
@@ -0,0 +1,108 @@
+#include "Compress/Policy.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "common/includes.h"
+
+namespace OpenPGP {
+namespace Compression {
+
+double entropy(const std::string & data) {
+    if (data.empty()) {
+        return 0;
+    }
+
+    std::size_t counts[256] = {};
+    for(char const c : data) {
+        counts[static_cast <uint8_t> (c)]++;
+    }
+
+    double bits = 0;
+    for(std::size_t const count : counts) {
+        if (count) {
+            const double p = static_cast <double> (count) / data.size();
+            bits -= p * std::log2(p);
+        }
+    }
+
+    return bits;
+}
+
+Decision decide(const uint8_t alg, const std::string & data, const int level, const int strategy) {
+    Decision decision = {alg, level, strategy, data.size(), 0, -1, -1, ""};
+
+    if (alg == ID::UNCOMPRESSED) {
+        decision.level = Z_DEFAULT_COMPRESSION;
+        decision.reason = "compression not requested";
+        return decision;
+    }
+
+    if (level != LEVEL_AUTO) {
+        decision.reason = "level set by caller";
+        return decision;
+    }
+
+    decision.level = Z_DEFAULT_COMPRESSION;
+
+    if (data.empty()) {
+        decision.reason = "no data";
+        return decision;
+    }
+
+    const std::string sample = data.substr(0, POLICY_SAMPLE);
+    decision.sampled = sample.size();
+
+    // already compressed or encrypted data looks random
+    decision.entropy = entropy(sample);
+    if (decision.entropy > POLICY_MAX_ENTROPY) {
+        decision.alg = ID::UNCOMPRESSED;
+        decision.reason = "sample entropy too high";
+        return decision;
+    }
+
+    // the fastest deflate level is enough to tell whether compression pays
+    std::string trial;
+    if (zlib_compress(sample, trial, DEFLATE_WINDOWBITS, 1) != Z_OK) {
+        decision.reason = "trial compression failed";
+        return decision;
+    }
+
+    decision.ratio = static_cast <double> (trial.size()) / sample.size();
+    if (decision.ratio > POLICY_SKIP_RATIO) {
+        decision.alg = ID::UNCOMPRESSED;
+        decision.reason = "sample does not compress";
+    }
+    else if (decision.ratio > POLICY_FAST_RATIO) {
+        decision.level = 1;                 // deflate level 1, or 100k bzip2 blocks
+        decision.reason = "sample compresses poorly; using the fastest level";
+    }
+    else {
+        decision.reason = "sample compresses well; using the default level";
+    }
+
+    return decision;
+}
+
+std::string show(const Decision & decision) {
+    std::stringstream out;
+    out << get_mapped(NAME, decision.alg);
+    if (decision.alg != ID::UNCOMPRESSED) {
+        out << " level " << decision.level << " strategy " << decision.strategy;
+    }
+    out << ": " << decision.reason << " (" << decision.size << " octets";
+    if (decision.sampled) {
+        out << ", sampled " << decision.sampled;
+    }
+    if (decision.entropy >= 0) {
+        out << ", entropy " << decision.entropy;
+    }
+    if (decision.ratio >= 0) {
+        out << ", ratio " << decision.ratio;
+    }
+    out << ")";
+    return out.str();
+}
+
+}
+}
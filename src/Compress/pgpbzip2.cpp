@@ -1,94 +1,390 @@
 #include "Compress/pgpbzip2.h"
 
-#include <assert.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
-int bz2_compress(const std::string & src, std::string & dst) {
-    int rc, flush;
-    bz_stream strm;
-    char *in = nullptr;
-    char out[bz2_BUFFER_SIZE];
+#include "common/ThreadPool.h"
+
+namespace OpenPGP {
+namespace Compression {
+
+namespace {
+
+// largest piece of input handed to libbz2 at once (avail_in is an unsigned int)
+const std::string::size_type MAX_AVAIL_IN = UINT_MAX;
+
+// 48 bit markers at the start of each block and at the end of the stream
+const uint64_t BLOCK_MAGIC = 0x314159265359ULL;
+const uint64_t END_MAGIC   = 0x177245385090ULL;
+
+// "BZh" and the block size digit
+const std::size_t HEADER_BITS = 32;
+
+// count (<= 57) bits of s starting at bit pos, most significant first
+uint64_t read_bits(const std::string & s, const uint64_t pos, const unsigned int count) {
+    uint64_t out = 0;
+    std::size_t byte = pos >> 3;
+    unsigned int have = 0;
+    while (have < count + (pos & 7)) {
+        out = (out << 8) | static_cast <uint8_t> (s[byte++]);
+        have += 8;
+    }
+    return (out >> (have - count - (pos & 7))) & ((1ULL << count) - 1);
+}
+
+class BitWriter {
+    private:
+        std::string out;
+        uint64_t acc;
+        unsigned int bits;
+
+    public:
+        BitWriter()
+            : out(),
+              acc(0),
+              bits(0)
+        {}
 
-    unsigned int index = 0;
-    unsigned int len = src.size();
+        void put(const uint64_t value, const unsigned int count) {
+            for(unsigned int i = count; i > 0;) {
+                const unsigned int take = std::min(i, 32U);
+                i -= take;
+                acc = (acc << take) | ((value >> i) & ((1ULL << take) - 1));
+                bits += take;
+                while (bits >= 8) {
+                    bits -= 8;
+                    out += static_cast <char> (acc >> bits);
+                }
+            }
+        }
 
-    dst.clear();      // clear out destination
-    dst.reserve(len); // reserve space to try to reduce reallocations
+        // bits [begin, end) of src
+        void copy(const std::string & src, uint64_t begin, const uint64_t end) {
+            while (begin + 32 <= end) {
+                put(read_bits(src, begin, 32), 32);
+                begin += 32;
+            }
+            if (begin < end) {
+                put(read_bits(src, begin, end - begin), end - begin);
+            }
+        }
 
+        // pad the last octet with zeros
+        std::string finish() {
+            if (bits) {
+                put(0, 8 - bits);
+            }
+            return out;
+        }
+};
+
+uint32_t rotl1(const uint32_t crc) {
+    return (crc << 1) | (crc >> 31);
+}
+
+// bit position of the end of stream marker in a stream libbz2 produced
+uint64_t find_end(const std::string & stream) {
+    const uint64_t total = static_cast <uint64_t> (stream.size()) << 3;
+    for(unsigned int pad = 0; (pad < 8) && (total >= HEADER_BITS + 80 + pad); pad++) {
+        const uint64_t pos = total - 80 - pad;
+        if ((read_bits(stream, pos, 48) == END_MAGIC) &&
+            (!pad || !read_bits(stream, total - pad, pad))) {
+            return pos;
+        }
+    }
+
+    throw std::runtime_error("Error: bzip2 end of stream marker not found.");
+}
+
+}
+
+Bz2Compressor::Bz2Compressor(const int blocksize100k)
+    : strm(),
+      finished(false)
+{
     strm.bzalloc = NULL;
     strm.bzfree = NULL;
     strm.opaque = NULL;
+    if (BZ2_bzCompressInit(&strm, blocksize100k, bz2_VERBOSITY, bz2_WORKFACTOR) != BZ_OK) {
+        throw std::runtime_error("Error: Could not initialize bzip2 compression.");
+    }
+}
 
-    rc = BZ2_bzCompressInit(&strm, bz2_BLOCKSIZE100K, bz2_VERBOSITY, bz2_WORKFACTOR);
-    if (rc != BZ_OK) {
-        BZ2_bzCompressEnd(&strm);
-        return rc;
+Bz2Compressor::~Bz2Compressor() {
+    BZ2_bzCompressEnd(&strm);
+}
+
+std::string Bz2Compressor::run(const std::string & data, const int action) {
+    if (finished) {
+        throw std::runtime_error("Error: Compressor was already finished.");
     }
 
-    do{
-        strm.avail_in = ((index + bz2_BUFFER_SIZE) < len)?bz2_BUFFER_SIZE:(len - index);
-        in = (char *) &src[index];
-        index += strm.avail_in;
-        flush = (index == len)?BZ_FINISH:BZ_RUN;
+    std::string dst;
+    char out[bz2_BUFFER_SIZE];
 
-        strm.next_in = in;
+    // BZ_RUN without input is a parameter error
+    if ((action == BZ_RUN) && data.empty()) {
+        return dst;
+    }
 
-        do{
-            strm.next_out = out;
-            strm.avail_out = bz2_BUFFER_SIZE;
+    std::string::size_type index = 0;
+    do {
+        const std::string::size_type len = std::min(data.size() - index, MAX_AVAIL_IN);
+        strm.next_in = (char *) data.data() + index;
+        strm.avail_in = len;
+        index += len;
 
-            rc = BZ2_bzCompress(&strm, flush);
-            assert(rc != BZ_SEQUENCE_ERROR);
-            dst += std::string(out, bz2_BUFFER_SIZE - strm.avail_out);
-        } while (strm.avail_out == 0);
-        assert (strm.avail_in == 0);
+        const int mode = (index == data.size())?action:BZ_RUN;
 
-    } while (flush != BZ_FINISH);
-    assert(rc == BZ_STREAM_END);
+        int rc;
+        do {
+            strm.next_out = out;
+            strm.avail_out = bz2_BUFFER_SIZE;
+            rc = BZ2_bzCompress(&strm, mode);
+            if (rc < 0) {
+                throw std::runtime_error("Error: bzip2 compression failed: " + std::to_string(rc));
+            }
+            dst.append(out, bz2_BUFFER_SIZE - strm.avail_out);
+        } while ((mode == BZ_FINISH)?(rc != BZ_STREAM_END):strm.avail_in);
+    } while (index < data.size());
 
-    return BZ2_bzCompressEnd(&strm);
+    return dst;
 }
 
-int bz2_decompress(const std::string & src, std::string & dst) {
-    int rc;
-    bz_stream strm;
-    char *in = nullptr;
-    char out[bz2_BUFFER_SIZE];
-
-    unsigned int index = 0;
-    unsigned int len = src.size();
+std::string Bz2Compressor::update(const std::string & data) {
+    return run(data, BZ_RUN);
+}
 
-    dst.clear();      // clear out destination
-    dst.reserve(len); // reserve space to try to reduce reallocations
+std::string Bz2Compressor::finish() {
+    std::string dst = run("", BZ_FINISH);
+    finished = true;
+    return dst;
+}
 
+Bz2Decompressor::Bz2Decompressor()
+    : strm(),
+      ended(false)
+{
     strm.bzalloc = NULL;
     strm.bzfree = NULL;
     strm.opaque = NULL;
-
-    rc = BZ2_bzDecompressInit(&strm, bz2_VERBOSITY, bz2_SMALL);
-    if (rc != BZ_OK) {
-        BZ2_bzCompressEnd(&strm);
-        return rc;
+    if (BZ2_bzDecompressInit(&strm, bz2_VERBOSITY, bz2_SMALL) != BZ_OK) {
+        throw std::runtime_error("Error: Could not initialize bzip2 decompression.");
     }
+}
 
-    do{
-        strm.avail_in = ((index + bz2_BUFFER_SIZE) < len)?bz2_BUFFER_SIZE:(len - index);
-        in = (char *) &src[index];
-        index += strm.avail_in;
+Bz2Decompressor::~Bz2Decompressor() {
+    BZ2_bzDecompressEnd(&strm);
+}
 
-        strm.next_in = in;
+bool Bz2Decompressor::feed(const std::string & data, const Sink & sink) {
+    char out[bz2_BUFFER_SIZE];
 
-        do{
+    std::string::size_type index = 0;
+    while (!ended && (index < data.size())) {
+        const std::string::size_type len = std::min(data.size() - index, MAX_AVAIL_IN);
+        strm.next_in = (char *) data.data() + index;
+        strm.avail_in = len;
+        index += len;
+
+        do {
             strm.next_out = out;
             strm.avail_out = bz2_BUFFER_SIZE;
+            const int rc = BZ2_bzDecompress(&strm);
+            if (rc < 0) {
+                throw std::runtime_error("Error: Compressed data is corrupt.");
+            }
+            ended = (rc == BZ_STREAM_END);
+            if ((strm.avail_out != bz2_BUFFER_SIZE) && !sink(std::string(out, bz2_BUFFER_SIZE - strm.avail_out))) {
+                return false;
+            }
+        } while (!ended && (strm.avail_in || !strm.avail_out));
+    }
+
+    return true;
+}
+
+std::string Bz2Decompressor::finish() {
+    if (!ended) {
+        throw std::runtime_error("Error: Compressed data is incomplete.");
+    }
+    return "";
+}
+
+bool Bz2Decompressor::done() const {
+    return ended;
+}
 
-            rc = BZ2_bzDecompress(&strm);
-            assert((rc == BZ_OK) || (rc == BZ_STREAM_END));
+}
+}
 
-            dst += std::string(out, bz2_BUFFER_SIZE - strm.avail_out);
-        } while (strm.avail_out == 0);
-        assert (strm.avail_in == 0);
+int bz2_compress(const std::string & src, std::string & dst) {
+    try {
+        OpenPGP::Compression::Bz2Compressor compressor;
+        dst = compressor.update(src);
+        dst += compressor.finish();
+    }
+    catch (const std::runtime_error &) {
+        return BZ_SEQUENCE_ERROR;
+    }
+    return BZ_OK;
+}
 
-    } while (rc != BZ_STREAM_END);
+int bz2_decompress(const std::string & src, std::string & dst) {
+    try {
+        OpenPGP::Compression::Bz2Decompressor decompressor;
+        dst = decompressor.update(src);
+        dst += decompressor.finish();
+    }
+    catch (const std::runtime_error &) {
+        return BZ_DATA_ERROR;
+    }
+    return BZ_OK;
+}
+
+int bz2_compress_parallel(const std::string & src, std::string & dst, int blocksize100k, std::size_t threads) {
+    using namespace OpenPGP::Compression;
+
+    if ((blocksize100k < 1) || (9 < blocksize100k)) {
+        return BZ_PARAM_ERROR;
+    }
+
+    // libbz2 ends a block after 100000 * blocksize100k - 19 octets of
+    // run length encoded input, which is at most 5/4 of the raw input
+    const std::size_t piece = (100000 * blocksize100k - 19) / 5 * 4;
+    if (src.size() <= piece) {
+        try {
+            Bz2Compressor compressor(blocksize100k);
+            dst = compressor.update(src);
+            dst += compressor.finish();
+        }
+        catch (const std::runtime_error &) {
+            return BZ_SEQUENCE_ERROR;
+        }
+        return BZ_OK;
+    }
+
+    const std::size_t count = (src.size() + piece - 1) / piece;
+    std::vector <std::string> streams(count);
+
+    try {
+        OpenPGP::ThreadPool pool(std::min(threads?threads:std::thread::hardware_concurrency(), count));
+        for(std::size_t i = 0; i < count; i++) {
+            pool.submit([&, i]() {
+                Bz2Compressor compressor(blocksize100k);
+                streams[i] = compressor.update(src.substr(i * piece, piece));
+                streams[i] += compressor.finish();
+            });
+        }
+        pool.wait();
+
+        // each stream holds one block; its combined CRC is the block CRC
+        BitWriter out;
+        out.put(read_bits(streams[0], 0, HEADER_BITS), HEADER_BITS);
+        uint32_t combined = 0;
+        for(std::string const & stream : streams) {
+            const uint64_t end = find_end(stream);
+            out.copy(stream, HEADER_BITS, end);
+            combined = rotl1(combined) ^ static_cast <uint32_t> (read_bits(stream, end + 48, 32));
+        }
+        out.put(END_MAGIC, 48);
+        out.put(combined, 32);
+        dst = out.finish();
+    }
+    catch (const std::runtime_error &) {
+        return BZ_SEQUENCE_ERROR;
+    }
+
+    return BZ_OK;
+}
+
+int bz2_decompress_parallel(const std::string & src, std::string & dst, std::size_t threads) {
+    using namespace OpenPGP::Compression;
+
+    if ((src.size() < 4) || (src.substr(0, 3) != "BZh") || (src[3] < '1') || ('9' < src[3])) {
+        return bz2_decompress(src, dst);
+    }
+
+    // bit positions of the block markers and the end of stream marker
+    std::vector <uint64_t> blocks;
+    uint64_t end = 0;
+    {
+        const uint64_t MASK = (1ULL << 48) - 1;
+        uint64_t window = 0;
+        uint64_t pos = HEADER_BITS;
+        for(std::size_t i = HEADER_BITS >> 3; (i < src.size()) && !end; i++) {
+            const uint8_t octet = src[i];
+            for(int bit = 7; bit >= 0; bit--) {
+                window = ((window << 1) | ((octet >> bit) & 1)) & MASK;
+                pos++;
+                if (pos < HEADER_BITS + 48) {
+                    continue;
+                }
+
+                if (window == BLOCK_MAGIC) {
+                    blocks.push_back(pos - 48);
+                }
+                else if (window == END_MAGIC) {
+                    end = pos - 48;
+                    break;
+                }
+            }
+        }
+    }
+
+    // a marker may also appear by chance inside compressed data, in which
+    // case the CRCs or the decoding of a piece will not work out
+    if ((blocks.size() < 2) || !end || (blocks[0] != HEADER_BITS) ||
+        ((end + 80) > (static_cast <uint64_t> (src.size()) << 3))) {
+        return bz2_decompress(src, dst);
+    }
+
+    uint32_t combined = 0;
+    for(uint64_t const block : blocks) {
+        combined = rotl1(combined) ^ static_cast <uint32_t> (read_bits(src, block + 48, 32));
+    }
+    if (combined != read_bits(src, end + 48, 32)) {
+        return bz2_decompress(src, dst);
+    }
+
+    std::vector <std::string> out(blocks.size());
+    try {
+        OpenPGP::ThreadPool pool(std::min(threads?threads:std::thread::hardware_concurrency(), blocks.size()));
+        for(std::size_t i = 0; i < blocks.size(); i++) {
+            pool.submit([&, i]() {
+                // standalone stream holding only this block
+                const uint64_t stop = ((i + 1) < blocks.size())?blocks[i + 1]:end;
+                BitWriter piece;
+                piece.put(read_bits(src, 0, HEADER_BITS), HEADER_BITS);
+                piece.copy(src, blocks[i], stop);
+                piece.put(END_MAGIC, 48);
+                piece.put(read_bits(src, blocks[i] + 48, 32), 32);
+
+                Bz2Decompressor decompressor;
+                out[i] = decompressor.update(piece.finish());
+                out[i] += decompressor.finish();
+            });
+        }
+        pool.wait();
+    }
+    catch (const std::runtime_error &) {
+        return bz2_decompress(src, dst);
+    }
+
+    std::size_t size = 0;
+    for(std::string const & o : out) {
+        size += o.size();
+    }
+
+    dst.clear();
+    dst.reserve(size);
+    for(std::string const & o : out) {
+        dst += o;
+    }
 
-    return BZ2_bzDecompressEnd(&strm);
+    return BZ_OK;
 }
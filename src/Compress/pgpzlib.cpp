@@ -1,154 +1,297 @@
 #include "Compress/pgpzlib.h"
 
-#include <assert.h>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <vector>
 
-#include "common/compiler.h"
+#include "common/ThreadPool.h"
+
+namespace OpenPGP {
+namespace Compression {
+
+namespace {
+
+// largest piece of input handed to zlib at once (avail_in is a uInt)
+const std::string::size_type MAX_AVAIL_IN = UINT_MAX;
+
+// raw deflate of src[start, start + len), primed with the octets before it
+std::string deflate_block(const std::string & src, const std::size_t start, const std::size_t len, const int level, const int strategy, const bool last) {
+    z_stream strm = z_stream();
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    if (deflateInit2(&strm, level, Z_DEFLATED, DEFLATE_WINDOWBITS, 8, strategy) != Z_OK) {
+        throw std::runtime_error("Error: Could not initialize deflate.");
+    }
+
+    const std::size_t history = std::min(start, (std::size_t) ZLIB_DICTIONARY);
+    if (history && (deflateSetDictionary(&strm, (const Bytef *) src.data() + start - history, history) != Z_OK)) {
+        (void) deflateEnd(&strm);
+        throw std::runtime_error("Error: Could not set deflate dictionary.");
+    }
+
+    std::string dst;
+    dst.reserve(deflateBound(&strm, len));
 
-/* Compress from file source to file dest until EOF on source.
-   def() returns Z_OK on success, Z_MEM_ERROR if memory could not be
-   allocated for processing, Z_STREAM_ERROR if an invalid compression
-   level is supplied, Z_VERSION_ERROR if the version of zlib.h and the
-   version of the library linked do not match, or Z_ERRNO if there is
-   an error reading or writing the files. */
-int zlib_compress(const std::string & src, std::string & dst, int windowBits, int level)
-{
-    int ret, flush;
-    unsigned have;
-    z_stream strm;
-    unsigned char *in = nullptr;
     unsigned char out[ZLIB_CHUNK];
+    strm.next_in = (Bytef *) src.data() + start;
+    strm.avail_in = len;
+
+    // the last block ends the stream; the others end on a byte boundary
+    // with an empty stored block so the next block can be appended
+    const int flush = last?Z_FINISH:Z_SYNC_FLUSH;
+    do {
+        strm.avail_out = ZLIB_CHUNK;
+        strm.next_out = out;
+        if (deflate(&strm, flush) == Z_STREAM_ERROR) {
+            (void) deflateEnd(&strm);
+            throw std::runtime_error("Error: Deflate state clobbered.");
+        }
+        dst.append((char *) out, ZLIB_CHUNK - strm.avail_out);
+    } while (strm.avail_out == 0);
+
+    (void) deflateEnd(&strm);
+    return dst;
+}
+
+// RFC 1950 sec 2.2 header for a 32K window at the given level
+std::string zlib_header(int level, const int strategy) {
+    if (level == Z_DEFAULT_COMPRESSION) {
+        level = 6;
+    }
 
-    unsigned int index = 0;
-    unsigned int len = src.size();
+    // FLEVEL as zlib sets it
+    const unsigned int flevel = ((strategy >= Z_HUFFMAN_ONLY) || (level < 2))?0:(level < 6)?1:(level == 6)?2:3;
+    unsigned int header = (0x78 << 8) | (flevel << 6);
+    header += 31 - (header % 31);
 
-    dst.clear();      // clear out destination
-    dst.reserve(len); // reserve space to try to reduce reallocations
+    return std::string(1, header >> 8) + std::string(1, header & 0xff);
+}
 
-    /* allocate deflate state */
+}
+
+ZlibCompressor::ZlibCompressor(const int windowBits, const int level, const int strategy)
+    : strm(),
+      finished(false)
+{
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
     strm.opaque = Z_NULL;
-    ret = deflateInit2(&strm, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
-    if (ret != Z_OK)
-        return ret;
+    if (deflateInit2(&strm, level, Z_DEFLATED, windowBits, 8, strategy) != Z_OK) {
+        throw std::runtime_error("Error: Could not initialize deflate.");
+    }
+}
+
+ZlibCompressor::~ZlibCompressor() {
+    (void) deflateEnd(&strm);
+}
+
+std::string ZlibCompressor::run(const std::string & data, const int flush) {
+    if (finished) {
+        throw std::runtime_error("Error: Compressor was already finished.");
+    }
+
+    std::string dst;
+    unsigned char out[ZLIB_CHUNK];
 
-    /* compress until end of file */
+    std::string::size_type index = 0;
     do {
-        // strm.avail_in = fread(in, 1, CHUNK, source);
-        // if (ferror(source)) {
-            // (void)deflateEnd(&strm);
-            // return Z_ERRNO;
-        // }
-        // flush = feof(source) ? Z_FINISH : Z_NO_FLUSH;
-
-        strm.avail_in = ((index + ZLIB_CHUNK) < len)?ZLIB_CHUNK:(len - index);
-        in = (unsigned char *) &src[index];
-        index += strm.avail_in;
-        flush = (index == len)? Z_FINISH : Z_NO_FLUSH;
-
-        strm.next_in = in;
-
-        /* run deflate() on input until output buffer not full, finish
-           compression if all of source has been read in */
+        const std::string::size_type len = std::min(data.size() - index, MAX_AVAIL_IN);
+        strm.next_in = (Bytef *) data.data() + index;
+        strm.avail_in = len;
+        index += len;
+
+        const int mode = (index == data.size())?flush:Z_NO_FLUSH;
+
+        /* run deflate() on input until output buffer not full */
         do {
             strm.avail_out = ZLIB_CHUNK;
             strm.next_out = out;
-            ret = deflate(&strm, flush);    /* no bad return value */
-            assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
-            have = ZLIB_CHUNK - strm.avail_out;
-            // if (fwrite(out, 1, have, dest) != have || ferror(dest)) {
-                // (void)deflateEnd(&strm);
-                // return Z_ERRNO;
-            // }
-            dst += std::string((char *) out, have);
+            if (deflate(&strm, mode) == Z_STREAM_ERROR) {
+                throw std::runtime_error("Error: Deflate state clobbered.");
+            }
+            dst.append((char *) out, ZLIB_CHUNK - strm.avail_out);
         } while (strm.avail_out == 0);
-        assert(strm.avail_in == 0);     /* all input will be used */
-
-        /* done when last data in file processed */
-    } while (flush != Z_FINISH);
-    assert(ret == Z_STREAM_END);        /* stream will be complete */
+    } while (index < data.size());
 
-    /* clean up and return */
-    (void)deflateEnd(&strm);
-    return Z_OK;
+    return dst;
 }
 
-/* Decompress from file source to file dest until stream ends or EOF.
-   inf() returns Z_OK on success, Z_MEM_ERROR if memory could not be
-   allocated for processing, Z_DATA_ERROR if the deflate data is
-   invalid or incomplete, Z_VERSION_ERROR if the version of zlib.h and
-   the version of the library linked do not match, or Z_ERRNO if there
-   is an error reading or writing the files. */
-int zlib_decompress(const std::string & src, std::string & dst, int windowBits)
-{
-    int ret;
-    unsigned have;
-    z_stream strm;
-    unsigned char *in = nullptr;
-    unsigned char out[ZLIB_CHUNK];
-
-    unsigned int index = 0;
-    unsigned int len = src.size();
+std::string ZlibCompressor::update(const std::string & data) {
+    return run(data, Z_NO_FLUSH);
+}
 
-    dst.clear();      // clear out destination
-    dst.reserve(len); // reserve space to try to reduce reallocations
+std::string ZlibCompressor::finish() {
+    std::string dst = run("", Z_FINISH);
+    finished = true;
+    return dst;
+}
 
-    /* allocate inflate state */
+ZlibDecompressor::ZlibDecompressor(const int windowBits)
+    : strm(),
+      ended(false)
+{
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
     strm.opaque = Z_NULL;
     strm.avail_in = 0;
     strm.next_in = Z_NULL;
-    ret = inflateInit2(&strm, windowBits);
-    if (ret != Z_OK)
-        return ret;
+    if (inflateInit2(&strm, windowBits) != Z_OK) {
+        throw std::runtime_error("Error: Could not initialize inflate.");
+    }
+}
 
-    /* decompress until deflate stream ends or end of file */
-    do {
-        // strm.avail_in = fread(in, 1, CHUNK, source);
-        // if (ferror(source)) {
-            // (void)inflateEnd(&strm);
-            // return Z_ERRNO;
-        // }
+ZlibDecompressor::~ZlibDecompressor() {
+    (void) inflateEnd(&strm);
+}
 
-        strm.avail_in = ((index + ZLIB_CHUNK) < len)?ZLIB_CHUNK:(len - index);
-        in = (unsigned char *) &src[index];
-        index += strm.avail_in;
+bool ZlibDecompressor::feed(const std::string & data, const Sink & sink) {
+    unsigned char out[ZLIB_CHUNK];
 
-        if (strm.avail_in == 0)
-            break;
-        strm.next_in = in;
+    std::string::size_type index = 0;
+    while (!ended && (index < data.size())) {
+        const std::string::size_type len = std::min(data.size() - index, MAX_AVAIL_IN);
+        strm.next_in = (Bytef *) data.data() + index;
+        strm.avail_in = len;
+        index += len;
 
         /* run inflate() on input until output buffer not full */
         do {
             strm.avail_out = ZLIB_CHUNK;
             strm.next_out = out;
-            ret = inflate(&strm, Z_NO_FLUSH);
-            assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
+            const int ret = inflate(&strm, Z_NO_FLUSH);
             switch (ret) {
-            case Z_NEED_DICT:
-                ret = Z_DATA_ERROR;     /* and fall through */
-                FALL_THROUGH;
-            case Z_DATA_ERROR:
-                FALL_THROUGH;
-            case Z_MEM_ERROR:
-                (void)inflateEnd(&strm);
-                return ret;
+                case Z_NEED_DICT:
+                case Z_DATA_ERROR:
+                case Z_STREAM_ERROR:
+                    throw std::runtime_error("Error: Compressed data is corrupt.");
+                case Z_MEM_ERROR:
+                    throw std::runtime_error("Error: Out of memory while inflating.");
+                case Z_STREAM_END:
+                    ended = true;
+                    break;
+                default:
+                    break;
             }
-            have = ZLIB_CHUNK - strm.avail_out;
+            if ((strm.avail_out != ZLIB_CHUNK) && !sink(std::string((char *) out, ZLIB_CHUNK - strm.avail_out))) {
+                return false;
+            }
+        } while (!ended && (strm.avail_out == 0));
+    }
 
-            // if (fwrite(out, 1, have, dest) != have || ferror(dest)) {
-                // (void)inflateEnd(&strm);
-                // return Z_ERRNO;
-            // }
+    return true;
+}
 
-            dst += std::string((char *) out, have);
-        } while (strm.avail_out == 0);
+std::string ZlibDecompressor::finish() {
+    if (!ended) {
+        throw std::runtime_error("Error: Compressed data is incomplete.");
+    }
+    return "";
+}
+
+bool ZlibDecompressor::done() const {
+    return ended;
+}
 
-        /* done when inflate() says it's done */
-    } while (ret != Z_STREAM_END);
+}
+}
 
-    /* clean up and return */
-    (void)inflateEnd(&strm);
-    return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
+int zlib_compress(const std::string & src, std::string & dst, int windowBits, int level) {
+    try {
+        OpenPGP::Compression::ZlibCompressor deflater(windowBits, level);
+        dst = deflater.update(src);
+        dst += deflater.finish();
+    }
+    catch (const std::runtime_error &) {
+        return Z_STREAM_ERROR;
+    }
+    return Z_OK;
+}
+
+int zlib_decompress(const std::string & src, std::string & dst, int windowBits) {
+    try {
+        OpenPGP::Compression::ZlibDecompressor inflater(windowBits);
+        dst = inflater.update(src);
+        dst += inflater.finish();
+    }
+    catch (const std::runtime_error &) {
+        return Z_DATA_ERROR;
+    }
+    return Z_OK;
+}
+
+int zlib_compress_parallel(const std::string & src, std::string & dst, int windowBits, int level, int strategy, std::size_t threads, std::size_t block) {
+    if ((windowBits != ZLIB_WINDOWBITS) && (windowBits != DEFLATE_WINDOWBITS)) {
+        return Z_STREAM_ERROR;
+    }
+
+    if (!block || (block > UINT_MAX)) {
+        block = ZLIB_PARALLEL_BLOCK;
+    }
+
+    // nothing to split
+    if (src.size() <= block) {
+        try {
+            OpenPGP::Compression::ZlibCompressor deflater(windowBits, level, strategy);
+            dst = deflater.update(src);
+            dst += deflater.finish();
+        }
+        catch (const std::runtime_error &) {
+            return Z_STREAM_ERROR;
+        }
+        return Z_OK;
+    }
+
+    const std::size_t count = (src.size() + block - 1) / block;
+    std::vector <std::string> out(count);
+    std::vector <uLong> check(count);
+
+    try {
+        OpenPGP::ThreadPool pool(std::min(threads?threads:std::thread::hardware_concurrency(), count));
+        for(std::size_t i = 0; i < count; i++) {
+            pool.submit([&, i]() {
+                const std::size_t start = i * block;
+                const std::size_t len = std::min(block, src.size() - start);
+                out[i] = OpenPGP::Compression::deflate_block(src, start, len, level, strategy, i == (count - 1));
+                if (windowBits == ZLIB_WINDOWBITS) {
+                    check[i] = adler32(adler32(0, Z_NULL, 0), (const Bytef *) src.data() + start, len);
+                }
+            });
+        }
+        pool.wait();
+    }
+    catch (const std::runtime_error &) {
+        return Z_STREAM_ERROR;
+    }
+
+    std::size_t size = 6;
+    for(std::string const & o : out) {
+        size += o.size();
+    }
+
+    dst.clear();
+    dst.reserve(size);
+
+    if (windowBits == ZLIB_WINDOWBITS) {
+        dst += OpenPGP::Compression::zlib_header(level, strategy);
+    }
+
+    for(std::string const & o : out) {
+        dst += o;
+    }
+
+    if (windowBits == ZLIB_WINDOWBITS) {
+        // Adler-32 of the whole input, big endian
+        uLong adler = check[0];
+        for(std::size_t i = 1; i < count; i++) {
+            adler = adler32_combine(adler, check[i], std::min(block, src.size() - i * block));
+        }
+
+        for(int shift = 24; shift >= 0; shift -= 8) {
+            dst += std::string(1, (adler >> shift) & 0xff);
+        }
+    }
+
+    return Z_OK;
 }
@@ -8,6 +8,12 @@ bool valid(const uint8_t alg) {
 }
 
 SymAlg::Ptr setup(const uint8_t sym_alg, const std::string & key) {
+    #ifdef OPENSSL_SYM
+    if (EVP::enabled(sym_alg)) {
+        return std::make_shared <EVP> (sym_alg, key);
+    }
+    #endif
+
     SymAlg::Ptr alg;
     switch(sym_alg) {
         case Sym::ID::IDEA:
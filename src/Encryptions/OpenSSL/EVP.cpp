@@ -0,0 +1,144 @@
+#include "Encryptions/OpenSSL/EVP.h"
+
+#include <map>
+#include <stdexcept>
+
+#include "common/Backend.h"
+#include "Encryptions/Encryptions.h"
+
+namespace OpenPGP {
+namespace Sym {
+
+const EVP_CIPHER * EVP::cipher(const uint8_t alg) {
+    switch (alg) {
+        #ifndef OPENSSL_NO_IDEA
+        case ID::IDEA:
+            return EVP_idea_ecb();
+        #endif
+        case ID::TRIPLEDES:
+            return EVP_des_ede3_ecb();
+        #ifndef OPENSSL_NO_CAST
+        case ID::CAST5:
+            return EVP_cast5_ecb();
+        #endif
+        #ifndef OPENSSL_NO_BF
+        case ID::BLOWFISH:
+            return EVP_bf_ecb();
+        #endif
+        case ID::AES128:
+            return EVP_aes_128_ecb();
+        case ID::AES192:
+            return EVP_aes_192_ecb();
+        case ID::AES256:
+            return EVP_aes_256_ecb();
+        #ifndef OPENSSL_NO_CAMELLIA
+        case ID::CAMELLIA128:
+            return EVP_camellia_128_ecb();
+        case ID::CAMELLIA192:
+            return EVP_camellia_192_ecb();
+        case ID::CAMELLIA256:
+            return EVP_camellia_256_ecb();
+        #endif
+        default:                        // EVP has no Twofish
+            break;
+    }
+
+    return nullptr;
+}
+
+bool EVP::supported(const uint8_t alg) {
+    // legacy ciphers (IDEA, CAST5, Blowfish) only exist when the
+    // legacy provider is loaded, so try to use each one once
+    static const std::map <uint8_t, bool> probed = [](){
+        std::map <uint8_t, bool> out;
+        for(std::pair <const uint8_t, std::size_t> const & sym : KEY_LENGTH) {
+            bool ok = false;
+            const EVP_CIPHER * type = cipher(sym.first);
+            EVP_CIPHER_CTX * test = EVP_CIPHER_CTX_new();
+            if (type && test) {
+                const std::string key(sym.second >> 3, 0);
+                ok = (EVP_EncryptInit_ex(test, type, nullptr, (const unsigned char *) key.data(), nullptr) == 1);
+            }
+            EVP_CIPHER_CTX_free(test);
+            out[sym.first] = ok;
+        }
+        return out;
+    }();
+
+    std::map <uint8_t, bool>::const_iterator it = probed.find(alg);
+    return (it != probed.end()) && it->second;
+}
+
+bool EVP::enabled(const uint8_t alg) {
+    return (Backend::get() == Backend::ID::OPENSSL) && supported(alg);
+}
+
+EVP::EVP(const uint8_t alg, const std::string & key) :
+    SymAlg(),
+    alg(alg),
+    enc(EVP_CIPHER_CTX_new()),
+    dec(EVP_CIPHER_CTX_new())
+{
+    const EVP_CIPHER * type = cipher(alg);
+    if (!type) {
+        EVP_CIPHER_CTX_free(enc);
+        EVP_CIPHER_CTX_free(dec);
+        throw std::runtime_error("Error: OpenSSL does not provide symmetric key algorithm " + std::to_string(alg) + ".");
+    }
+
+    if (key.size() != (std::size_t) EVP_CIPHER_key_length(type)) {
+        EVP_CIPHER_CTX_free(enc);
+        EVP_CIPHER_CTX_free(dec);
+        throw std::runtime_error("Error: Key length does not match symmetric key algorithm.");
+    }
+
+    if (!enc || !dec ||
+        (EVP_EncryptInit_ex(enc, type, nullptr, (const unsigned char *) key.data(), nullptr) != 1) ||
+        (EVP_DecryptInit_ex(dec, type, nullptr, (const unsigned char *) key.data(), nullptr) != 1)) {
+        EVP_CIPHER_CTX_free(enc);
+        EVP_CIPHER_CTX_free(dec);
+        throw std::runtime_error("Error: Could not set up OpenSSL cipher.");
+    }
+
+    EVP_CIPHER_CTX_set_padding(enc, 0);
+    EVP_CIPHER_CTX_set_padding(dec, 0);
+    keyset = true;
+}
+
+EVP::~EVP() {
+    EVP_CIPHER_CTX_free(enc);
+    EVP_CIPHER_CTX_free(dec);
+}
+
+std::string EVP::run(EVP_CIPHER_CTX * ctx, const std::string & data) {
+    if (!keyset) {
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (data.size() % (blocksize() >> 3)) {
+        throw std::runtime_error("Error: Data must be a multiple of " + std::to_string(blocksize() >> 3) + " octets.");
+    }
+
+    std::string out(data.size(), 0);
+    int len = 0;
+    if (EVP_CipherUpdate(ctx, (unsigned char *) &out[0], &len, (const unsigned char *) data.data(), data.size()) != 1) {
+        throw std::runtime_error("Error: EVP_CipherUpdate failed.");
+    }
+
+    return out;
+}
+
+std::string EVP::encrypt(const std::string & DATA) {
+    return run(enc, DATA);
+}
+
+std::string EVP::decrypt(const std::string & DATA) {
+    return run(dec, DATA);
+}
+
+unsigned int EVP::blocksize() const {
+    return BLOCK_LENGTH.at(alg);
+}
+
+}
+}
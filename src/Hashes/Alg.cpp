@@ -1,12 +1,28 @@
 #include "Hashes/Alg.h"
 
+#include <algorithm>
+
 namespace OpenPGP {
 namespace Hash {
 
+namespace {
+
+// octets copied into a std::string at a time by update(data, len)
+const std::size_t UPDATE_SIZE = 65536;
+
+}
+
 Alg::Alg() {}
 
 Alg::~Alg() {}
 
+// implementations that can hash from a pointer should override this
+void Alg::update(const char * data, const std::size_t len) {
+    for(std::size_t i = 0; i < len; i += UPDATE_SIZE) {
+        update(std::string(data + i, std::min(UPDATE_SIZE, len - i)));
+    }
+}
+
 std::string Alg::digest() {
     return unhexlify(hexdigest());
 }
@@ -3,15 +3,70 @@
 namespace OpenPGP {
 namespace Hash {
 
+constexpr std::size_t Traits <ID::MD5>::LENGTH;
+constexpr std::size_t Traits <ID::SHA1>::LENGTH;
+constexpr std::size_t Traits <ID::RIPEMD160>::LENGTH;
+constexpr std::size_t Traits <ID::SHA256>::LENGTH;
+constexpr std::size_t Traits <ID::SHA384>::LENGTH;
+constexpr std::size_t Traits <ID::SHA512>::LENGTH;
+constexpr std::size_t Traits <ID::SHA224>::LENGTH;
+
 bool valid(const uint8_t alg) {
     return (NAME.find(alg) != NAME.end());
 }
 
+std::size_t length(const uint8_t alg) {
+    switch (alg) {
+        case ID::MD5:
+            return Traits <ID::MD5>::LENGTH;
+        case ID::SHA1:
+            return Traits <ID::SHA1>::LENGTH;
+        case ID::RIPEMD160:
+            return Traits <ID::RIPEMD160>::LENGTH;
+        case ID::SHA256:
+            return Traits <ID::SHA256>::LENGTH;
+        case ID::SHA384:
+            return Traits <ID::SHA384>::LENGTH;
+        case ID::SHA512:
+            return Traits <ID::SHA512>::LENGTH;
+        case ID::SHA224:
+            return Traits <ID::SHA224>::LENGTH;
+        default:
+            throw std::runtime_error("Error: Hash value not defined or reserved.");
+            break;
+    }
+
+    return 0;
+}
+
+namespace {
+
+// hash a single string with a stack allocated context
+struct Digest {
+    typedef std::string result_type;
+
+    const std::string & data;
+
+    template <typename H>
+    std::string operator()(H & ctx) const {
+        ctx.H::update(data);
+        return ctx.digest();
+    }
+};
+
+}
+
 std::string use(const uint8_t alg, const std::string & data) {
-    return get_instance(alg, data) -> digest();
+    return dispatch(alg, Digest{data});
 }
 
 Instance get_instance(const uint8_t alg, const std::string & data) {
+    #ifdef OPENSSL_HASH
+    if (EVP::enabled(alg)) {
+        return std::make_shared <EVP> (alg, data);
+    }
+    #endif
+
     Instance ptr = nullptr;
     switch (alg) {
         case ID::MD5:
@@ -0,0 +1,143 @@
+#include "Hashes/OpenSSL/EVP.h"
+
+#include <map>
+#include <stdexcept>
+
+#include "common/Backend.h"
+#include "Hashes/Hashes.h"
+
+namespace OpenPGP {
+namespace Hash {
+
+const EVP_MD * EVP::md(const uint8_t alg) {
+    switch (alg) {
+        case ID::MD5:
+            return EVP_md5();
+        case ID::SHA1:
+            return EVP_sha1();
+        case ID::RIPEMD160:
+            return EVP_ripemd160();
+        case ID::SHA256:
+            return EVP_sha256();
+        case ID::SHA384:
+            return EVP_sha384();
+        case ID::SHA512:
+            return EVP_sha512();
+        case ID::SHA224:
+            return EVP_sha224();
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+bool EVP::supported(const uint8_t alg) {
+    // providers (FIPS, legacy) can make a digest unavailable
+    // even though EVP_* returned a method, so probe each once
+    static const std::map <uint8_t, bool> probed = [](){
+        std::map <uint8_t, bool> out;
+        for(std::pair <const uint8_t, std::size_t> const & hash : LENGTH) {
+            bool ok = false;
+            const EVP_MD * type = md(hash.first);
+            EVP_MD_CTX * test = EVP_MD_CTX_new();
+            if (type && test) {
+                ok = (EVP_DigestInit_ex(test, type, nullptr) == 1);
+            }
+            EVP_MD_CTX_free(test);
+            out[hash.first] = ok;
+        }
+        return out;
+    }();
+
+    std::map <uint8_t, bool>::const_iterator it = probed.find(alg);
+    return (it != probed.end()) && it->second;
+}
+
+bool EVP::enabled(const uint8_t alg) {
+    return (Backend::get() == Backend::ID::OPENSSL) && supported(alg);
+}
+
+EVP::EVP(const uint8_t alg, const std::string & data) :
+    Alg(),
+    alg(alg),
+    ctx(EVP_MD_CTX_new())
+{
+    if (!ctx) {
+        throw std::runtime_error("Error: Could not allocate EVP_MD_CTX.");
+    }
+
+    if (EVP_DigestInit_ex(ctx, md(alg), nullptr) != 1) {
+        EVP_MD_CTX_free(ctx);
+        throw std::runtime_error("Error: OpenSSL does not provide hash algorithm " + std::to_string(alg) + ".");
+    }
+
+    update(data);
+}
+
+EVP::EVP(const EVP & copy) :
+    Alg(),
+    alg(copy.alg),
+    ctx(EVP_MD_CTX_new())
+{
+    if (!ctx || (EVP_MD_CTX_copy_ex(ctx, copy.ctx) != 1)) {
+        EVP_MD_CTX_free(ctx);
+        throw std::runtime_error("Error: Could not copy EVP_MD_CTX.");
+    }
+}
+
+EVP & EVP::operator=(const EVP & copy) {
+    if (this != &copy) {
+        if (EVP_MD_CTX_copy_ex(ctx, copy.ctx) != 1) {
+            throw std::runtime_error("Error: Could not copy EVP_MD_CTX.");
+        }
+        alg = copy.alg;
+    }
+
+    return *this;
+}
+
+EVP::~EVP() {
+    EVP_MD_CTX_free(ctx);
+}
+
+void EVP::update(const std::string & str) {
+    update(str.data(), str.size());
+}
+
+void EVP::update(const char * data, const std::size_t len) {
+    if (len && (EVP_DigestUpdate(ctx, data, len) != 1)) {
+        throw std::runtime_error("Error: EVP_DigestUpdate failed.");
+    }
+}
+
+std::string EVP::digest() {
+    // finalize a copy so that more data can still be added
+    EVP_MD_CTX * final = EVP_MD_CTX_new();
+    if (!final || (EVP_MD_CTX_copy_ex(final, ctx) != 1)) {
+        EVP_MD_CTX_free(final);
+        throw std::runtime_error("Error: Could not copy EVP_MD_CTX.");
+    }
+
+    unsigned char buf[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    const int rc = EVP_DigestFinal_ex(final, buf, &len);
+    EVP_MD_CTX_free(final);
+
+    if (rc != 1) {
+        throw std::runtime_error("Error: EVP_DigestFinal_ex failed.");
+    }
+
+    return std::string((char *) buf, len);
+}
+
+std::string EVP::hexdigest() {
+    return hexlify(digest());
+}
+
+std::size_t EVP::digestsize() const {
+    return EVP_MD_size(md(alg)) << 3;
+}
+
+}
+}
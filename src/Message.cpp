@@ -1,5 +1,7 @@
 #include "Message.h"
 
+#include <stdexcept>
+
 #include "Misc/CRC-24.h"
 
 namespace OpenPGP {
@@ -118,8 +120,7 @@ bool Message::decompress() {
     if ((packets.size() == 1) && (packets[0] -> get_tag() == Packet::COMPRESSED_DATA)) {
         comp.reset();
         comp = std::static_pointer_cast <Packet::Tag8> (packets[0]);
-        const std::string data = comp -> get_data();
-        comp -> set_data("");
+        const std::string data = comp -> get_data();   // kept by comp so raw() does not recompress
         comp -> set_partial(comp -> get_partial());
         packets.clear();
         read_raw(data);
@@ -232,25 +233,19 @@ std::string Message::raw(Status * status, const bool check_mpi) const {
     }
 
     if (comp) {                  // if compression was used; compress data
-        comp -> set_data(out);
+        comp -> set_data(out);   // only recompresses if the packets changed
         out = comp -> write();
-        comp -> set_data("");    // hold compressed data for as little time as possible
     }
     return out;
 }
 
 std::string Message::write(const PGP::Armored armor, Status * status, const bool check_mpi) const {
-    std::string packet_string = raw(status, check_mpi);
+    // raw() already puts the packets into a Compressed Data Packet if compression is used
+    const std::string packet_string = raw(status, check_mpi);
     if (status && (*status != Status::SUCCESS)) {
         return "";
     }
 
-    // put data into a Compressed Data Packet if compression is used
-    if (comp) {
-        comp -> set_data(packet_string);
-        packet_string = comp -> write();
-    }
-
     if ((armor == Armored::NO)                    || // no armor
         ((armor == Armored::DEFAULT) && !armored)) { // or use stored value, and stored value is no
         return packet_string;
@@ -380,4 +375,165 @@ PGP::Ptr Message::clone() const {
     return std::make_shared <Message> (*this);
 }
 
+namespace {
+
+// thrown inside of MessageReader to stop with a Status
+struct Failure {
+    Status status;
+};
+
+}
+
+const std::size_t MessageReader::MAX_DEPTH;
+
+MessageReader::MessageReader(const Output & literal,
+                             const Packet::PacketReader::Handler & other,
+                             const Compression::Budget & budget,
+                             const std::size_t depth)
+    : literal(literal),
+      other(other),
+      budget(budget),
+      depth(depth),
+      status(Status::SUCCESS),
+      reader([this](const uint8_t tag, const std::string & data, const bool last) { read_packet(tag, data, last); }),
+      header(),
+      in_body(false),
+      outer(nullptr),
+      decompressor(nullptr),
+      inner(nullptr)
+{}
+
+void MessageReader::read_packet(const uint8_t tag, const std::string & data, const bool last) {
+    switch (tag) {
+        case Packet::LITERAL_DATA:
+            read_literal(data, last);
+            break;
+        case Packet::COMPRESSED_DATA:
+            read_compressed(data, last);
+            break;
+        default:
+            if (other) {
+                other(tag, data, last);
+            }
+            break;
+    }
+
+    if (last) {
+        header.clear();
+        in_body = false;
+        decompressor = nullptr;
+        inner = nullptr;
+    }
+}
+
+void MessageReader::read_literal(const std::string & data, const bool last) {
+    // format, filename length, filename, and date come before the literal data
+    std::string::size_type pos = 0;
+    while (!in_body && (pos < data.size())) {
+        header += data[pos++];
+        in_body = (header.size() >= 2) && (header.size() == static_cast <std::size_t> (6 + static_cast <uint8_t> (header[1])));
+    }
+
+    if (!in_body) {
+        if (last) {
+            throw Failure{Status::INVALID_LENGTH};
+        }
+        return;
+    }
+
+    if (literal && (pos < data.size())) {
+        literal(pos?data.substr(pos):data);
+    }
+}
+
+void MessageReader::read_compressed(const std::string & data, const bool last) {
+    std::string::size_type pos = 0;
+    if (!in_body) {
+        if (data.empty()) {
+            if (last) {
+                throw Failure{Status::INVALID_LENGTH};
+            }
+            return;
+        }
+
+        const uint8_t alg = data[pos++];
+        if (!Compression::valid(alg) || (alg > Compression::ID::BZIP2)) {
+            throw Failure{Status::INVALID_COMPRESSION_ALGORITHM};
+        }
+
+        if (depth >= MAX_DEPTH) {
+            // "Error: Too many nested Compressed Data Packets.\n";
+            throw Failure{Status::INVALID};
+        }
+
+        // nested packets share the budget of the outermost one
+        if (outer) {
+            decompressor = std::make_shared <Compression::BudgetedDecompressor> (alg, *outer);
+        }
+        else {
+            decompressor = std::make_shared <Compression::BudgetedDecompressor> (alg, budget);
+        }
+        inner = std::make_shared <MessageReader> (literal, other, budget, depth + 1);
+        inner -> outer = decompressor;
+        in_body = true;
+    }
+
+    // failures of the inner packets have to get past the decompressor
+    Status inner_status = Status::SUCCESS;
+    Status rc = decompressor -> feed(pos?data.substr(pos):data, [&](const std::string & piece) {
+        inner_status = inner -> update(piece);
+        return inner_status == Status::SUCCESS;
+    });
+
+    if (inner_status != Status::SUCCESS) {
+        throw Failure{inner_status};
+    }
+
+    if (last && (rc == Status::SUCCESS)) {
+        rc = decompressor -> finish();
+    }
+
+    if (last && (rc == Status::SUCCESS)) {
+        rc = inner -> finish();
+    }
+
+    if (rc != Status::SUCCESS) {
+        throw Failure{rc};
+    }
+}
+
+Status MessageReader::update(const std::string & data) {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    try {
+        reader.update(data);
+    }
+    catch (const Failure & failure) {
+        status = failure.status;
+    }
+    catch (const std::exception &) {
+        // malformed packets can also throw std::logic_error
+        status = Status::INVALID;
+    }
+
+    return status;
+}
+
+Status MessageReader::finish() {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    try {
+        reader.finish();
+    }
+    catch (const std::exception &) {
+        status = Status::INVALID_LENGTH;
+    }
+
+    return status;
+}
+
 }
@@ -0,0 +1,95 @@
+#include "Misc/FixedBase.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace OpenPGP {
+
+const std::size_t FixedBase::WINDOW;
+
+FixedBase::FixedBase(const MPI & base, const MPI & mod, const std::size_t exp_bits) :
+    base_(base),
+    mod_(mod),
+    bits(exp_bits),
+    limbs(mpz_size(mod.get_mpz_t())),
+    table()
+{
+    if ((mod_ < 3) || ((mod_ & 1) == 0)) {
+        throw std::runtime_error("Error: Fixed base modulus must be odd.");
+    }
+
+    if (!bits) {
+        throw std::runtime_error("Error: Fixed base exponent size must be positive.");
+    }
+
+    const std::size_t windows = (bits + WINDOW - 1) / WINDOW;
+    const std::size_t entries = 1 << WINDOW;
+    table.assign(windows * entries * limbs, 0);
+
+    // g = base^(2^(WINDOW * i))
+    MPI g = base_ % mod_;
+    for(std::size_t i = 0; i < windows; i++) {
+        MPI value = 1;
+        for(std::size_t d = 0; d < entries; d++) {
+            mpz_export(&table[(i * entries + d) * limbs], nullptr, -1, sizeof(mp_limb_t), 0, 0, value.get_mpz_t());
+            value = (value * g) % mod_;
+        }
+
+        for(std::size_t s = 0; s < WINDOW; s++) {
+            g = (g * g) % mod_;
+        }
+    }
+}
+
+MPI FixedBase::powm_sec(const MPI & exp) const {
+    if ((exp < 0) || (mpz_sizeinbase(exp.get_mpz_t(), 2) > bits)) {
+        throw std::runtime_error("Error: Exponent is too large for fixed base table.");
+    }
+
+    const std::size_t windows = (bits + WINDOW - 1) / WINDOW;
+    const std::size_t entries = 1 << WINDOW;
+    const mp_size_t n = limbs;
+
+    std::vector <mp_limb_t> acc(n, 0);
+    std::vector <mp_limb_t> entry(n, 0);
+    std::vector <mp_limb_t> product(2 * n, 0);
+    std::vector <mp_limb_t> scratch(std::max(mpn_sec_mul_itch(n, n), mpn_sec_div_r_itch(2 * n, n)));
+
+    acc[0] = 1;
+
+    const mp_limb_t * m = mpz_limbs_read(mod_.get_mpz_t());
+    for(std::size_t i = 0; i < windows; i++) {
+        mp_size_t digit = 0;
+        for(std::size_t s = WINDOW; s > 0; s--) {
+            digit = (digit << 1) | mpz_tstbit(exp.get_mpz_t(), i * WINDOW + s - 1);
+        }
+
+        // acc = acc * table[i][digit] mod mod
+        mpn_sec_tabselect(entry.data(), &table[i * entries * n], n, entries, digit);
+        mpn_sec_mul(product.data(), acc.data(), n, entry.data(), n, scratch.data());
+        mpn_sec_div_r(product.data(), 2 * n, m, n, scratch.data());
+        std::copy(product.begin(), product.begin() + n, acc.begin());
+    }
+
+    MPI out;
+    mpz_import(out.get_mpz_t(), n, -1, sizeof(mp_limb_t), 0, 0, acc.data());
+    return out;
+}
+
+bool FixedBase::matches(const MPI & base, const MPI & mod) const {
+    return (mod_ == mod) && (base_ == base);
+}
+
+const MPI & FixedBase::get_base() const {
+    return base_;
+}
+
+const MPI & FixedBase::get_mod() const {
+    return mod_;
+}
+
+std::size_t FixedBase::get_exp_bits() const {
+    return bits;
+}
+
+}
@@ -202,4 +202,35 @@ std::string use_normal_CFB_decrypt(const uint8_t sym_alg, const std::string & da
     return normal_CFB_decrypt(alg, data, IV);
 }
 
+CFB::CFB(const SymAlg::Ptr & crypt, const bool decrypt, const std::string & IV)
+    : crypt(crypt),
+      decrypting(decrypt),
+      feedback(IV.size()?IV:std::string(crypt -> blocksize() >> 3, 0)),
+      keystream(),
+      used(0)
+{
+    if (feedback.size() != (crypt -> blocksize() >> 3)) {
+        throw std::runtime_error("Error: IV must be one block long.");
+    }
+
+    keystream = crypt -> encrypt(feedback);
+}
+
+std::string CFB::update(const std::string & data) {
+    const std::size_t BS = feedback.size();
+
+    std::string out = data;
+    for(std::string::size_type i = 0; i < out.size(); i++) {
+        if (used == BS) {
+            keystream = crypt -> encrypt(feedback);
+            used = 0;
+        }
+
+        out[i] ^= keystream[used];
+        feedback[used++] = decrypting?data[i]:out[i];
+    }
+
+    return out;
+}
+
 }
@@ -0,0 +1,74 @@
+#include "Misc/keywrap.h"
+
+namespace OpenPGP {
+
+namespace {
+
+const std::string IV = "\xa6\xa6\xa6\xa6\xa6\xa6\xa6\xa6";
+
+// xor the 64 bit big endian value t into the last octets of a
+void xor_t(std::string & a, uint64_t t) {
+    for(std::size_t i = 8; i-- > 0 && t; t >>= 8) {
+        a[i] ^= static_cast <char> (t & 0xff);
+    }
+}
+
+bool usable(const SymAlg::Ptr & crypt, const std::string & data) {
+    return crypt && (crypt -> blocksize() == 128) && (data.size() >= 16) && !(data.size() & 7);
+}
+
+}
+
+std::string key_wrap(const SymAlg::Ptr & crypt, const std::string & data) {
+    if (!usable(crypt, data)) {
+        throw std::runtime_error("Error: Bad key wrap input.");
+    }
+
+    const std::size_t n = data.size() >> 3;
+    std::string a = IV;
+    std::string r = data;
+    for(uint64_t j = 0; j < 6; j++) {
+        for(std::size_t i = 0; i < n; i++) {
+            const std::string b = crypt -> encrypt(a + r.substr(i << 3, 8));
+            a = b.substr(0, 8);
+            xor_t(a, n * j + i + 1);
+            r.replace(i << 3, 8, b, 8, 8);
+        }
+    }
+
+    return a + r;
+}
+
+std::string key_unwrap(const SymAlg::Ptr & crypt, const std::string & data) {
+    if (!usable(crypt, data) || (data.size() < 24)) {
+        return "";
+    }
+
+    const std::size_t n = (data.size() >> 3) - 1;
+    std::string a = data.substr(0, 8);
+    std::string r = data.substr(8);
+    for(uint64_t j = 6; j-- > 0;) {
+        for(std::size_t i = n; i-- > 0;) {
+            xor_t(a, n * j + i + 1);
+            const std::string b = crypt -> decrypt(a + r.substr(i << 3, 8));
+            a = b.substr(0, 8);
+            r.replace(i << 3, 8, b, 8, 8);
+        }
+    }
+
+    if (a != IV) {
+        return "";
+    }
+
+    return r;
+}
+
+std::string use_key_wrap(const uint8_t sym_alg, const std::string & data, const std::string & key) {
+    return key_wrap(Sym::setup(sym_alg, key), data);
+}
+
+std::string use_key_unwrap(const uint8_t sym_alg, const std::string & data, const std::string & key) {
+    return key_unwrap(Sym::setup(sym_alg, key), data);
+}
+
+}
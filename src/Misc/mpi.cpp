@@ -1,5 +1,7 @@
 #include "Misc/mpi.h"
 
+#include <algorithm>
+
 #include "Misc/pgptime.h"
 #include "RNG/RNGs.h"
 #include "common/includes.h"
@@ -58,6 +60,19 @@ void mpiswap(MPI & a, MPI & b) {
     std::swap(a, b);
 }
 
+void mpiwipe(MPI & a) {
+    mpz_ptr z = a.get_mpz_t();
+    const mp_size_t alloc = z -> _mp_alloc;
+    if (alloc > 0) {
+        // volatile so that the stores are not dropped
+        volatile mp_limb_t * limbs = mpz_limbs_modify(z, alloc);
+        for(mp_size_t i = 0; i < alloc; i++) {
+            limbs[i] = 0;
+        }
+    }
+    mpz_limbs_finish(z, 0);
+}
+
 MPI mpigcd(const MPI &a, const MPI &b) {
     MPI ret;
     mpz_gcd(ret.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
@@ -70,12 +85,65 @@ MPI nextprime(const MPI &a) {
     return ret;
 }
 
-MPI powm(const MPI &base, const MPI &exp, const MPI &mod) {
+MPI powm_sec(const MPI &base, const MPI &exp, const MPI &mod) {
     MPI ret;
     mpz_powm_sec(ret.get_mpz_t(), base.get_mpz_t(), exp.get_mpz_t(), mod.get_mpz_t());
     return ret;
 }
 
+MPI powm_pub(const MPI &base, const MPI &exp, const MPI &mod) {
+    MPI ret;
+    mpz_powm(ret.get_mpz_t(), base.get_mpz_t(), exp.get_mpz_t(), mod.get_mpz_t());
+    return ret;
+}
+
+MPI powm(const MPI &base, const MPI &exp, const MPI &mod) {
+    return powm_sec(base, exp, mod);
+}
+
+MPI powm2_pub(const MPI & base1, const MPI & exp1, const MPI & base2, const MPI & exp2, const MPI & mod) {
+    // 2 bit windows: table[i][j] = base1^i * base2^j
+    const unsigned int W = 2;
+    const unsigned int N = 1 << W;
+
+    MPI table[N][N];
+    table[0][0] = 1;
+    for(unsigned int i = 0; i < N; i++) {
+        if (i) {
+            table[i][0] = (table[i - 1][0] * base1) % mod;
+        }
+        for(unsigned int j = 1; j < N; j++) {
+            table[i][j] = (table[i][j - 1] * base2) % mod;
+        }
+    }
+
+    const std::size_t bits = std::max(mpz_sizeinbase(exp1.get_mpz_t(), 2),
+                                      mpz_sizeinbase(exp2.get_mpz_t(), 2));
+
+    MPI out = 1;
+    for(std::size_t w = (bits + W - 1) / W; w > 0; w--) {
+        const std::size_t bit = (w - 1) * W;
+
+        for(unsigned int s = 0; s < W; s++) {
+            out *= out;
+            out %= mod;
+        }
+
+        unsigned int i = 0, j = 0;
+        for(unsigned int s = W; s > 0; s--) {
+            i = (i << 1) | mpz_tstbit(exp1.get_mpz_t(), bit + s - 1);
+            j = (j << 1) | mpz_tstbit(exp2.get_mpz_t(), bit + s - 1);
+        }
+
+        if (i | j) {
+            out *= table[i][j];
+            out %= mod;
+        }
+    }
+
+    return out % mod;
+}
+
 MPI invert(const MPI &a, const MPI &b) {
     MPI ret;
     mpz_invert(ret.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
@@ -83,7 +151,7 @@ MPI invert(const MPI &a, const MPI &b) {
 }
 
 MPI random(unsigned int bits) {
-    return bintompi(RNG::RNG().rand_bits(bits));
+    return RNG::rand_mpi(bits);
 }
 
 // given some value, return the formatted mpi
@@ -0,0 +1,186 @@
+#include "Misc/prime.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "RNG/RNGs.h"
+
+namespace OpenPGP {
+namespace Prime {
+
+namespace {
+
+// odd and even primes below SIEVE_LIMIT
+const std::vector <unsigned long> & small_primes() {
+    static const std::vector <unsigned long> primes = [](){
+        std::vector <bool> composite(SIEVE_LIMIT, false);
+        std::vector <unsigned long> out;
+        for(unsigned long i = 2; i < SIEVE_LIMIT; i++) {
+            if (!composite[i]) {
+                out.push_back(i);
+                for(unsigned long j = i * i; j < SIEVE_LIMIT; j += i) {
+                    composite[j] = true;
+                }
+            }
+        }
+        return out;
+    }();
+
+    return primes;
+}
+
+// a^-1 mod s for prime s that does not divide a
+unsigned long invert_small(unsigned long a, const unsigned long s) {
+    unsigned long out = 1;
+    for(unsigned long e = s - 2; e; e >>= 1) {
+        if (e & 1) {
+            out = (out * a) % s;
+        }
+        a = (a * a) % s;
+    }
+    return out;
+}
+
+struct Search {
+    const MPI & start;
+    const MPI & step;
+
+    std::atomic <bool> found;
+    std::atomic <unsigned long> next;   // next chunk to claim
+    std::mutex mutex;
+    MPI result;
+
+    Search(const MPI & start, const MPI & step)
+        : start(start), step(step),
+          found(false), next(0),
+          mutex(), result(0)
+    {}
+};
+
+// mark candidates first + k * step in [0, CHUNK) that have a small factor
+void sieve(const MPI & first, const MPI & step, std::vector <bool> & composite) {
+    composite.assign(CHUNK, false);
+
+    for(unsigned long const s : small_primes()) {
+        // every candidate is larger than s, so none of them is s itself
+        if (first <= s) {
+            break;
+        }
+
+        const unsigned long r  = mpz_fdiv_ui(first.get_mpz_t(), s);
+        const unsigned long ss = mpz_fdiv_ui(step.get_mpz_t(), s);
+        if (!ss) {
+            // s divides either all of the candidates or none of them
+            if (!r) {
+                composite.assign(CHUNK, true);
+                return;
+            }
+            continue;
+        }
+
+        // r + k * ss = 0 mod s
+        for(unsigned long k = (((s - r) % s) * invert_small(ss, s)) % s; k < CHUNK; k += s) {
+            composite[k] = true;
+        }
+    }
+}
+
+void work(Search & search) {
+    std::vector <bool> composite;
+    MPI first, candidate;
+    while (!search.found) {
+        const unsigned long chunk = search.next++;
+        first = search.start + search.step * chunk * CHUNK;
+        sieve(first, search.step, composite);
+
+        for(std::size_t k = 0; k < CHUNK; k++) {
+            if (search.found) {
+                return;
+            }
+
+            if (composite[k]) {
+                continue;
+            }
+
+            candidate = first + search.step * k;
+            if (mpz_probab_prime_p(candidate.get_mpz_t(), ROUNDS)) {
+                std::lock_guard <std::mutex> lock(search.mutex);
+                if (!search.found) {
+                    search.result = candidate;
+                    search.found = true;
+                }
+                return;
+            }
+        }
+    }
+}
+
+}
+
+unsigned int default_threads() {
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count?count:1;
+}
+
+MPI progression(const MPI & start, const MPI & step, unsigned int threads) {
+    if ((start <= 0) || (step <= 0)) {
+        throw std::runtime_error("Error: Prime search needs positive start and step.");
+    }
+
+    if (mpigcd(start, step) != 1) {
+        throw std::runtime_error("Error: Prime search start and step share a factor.");
+    }
+
+    // small values are handled directly
+    if (start < SIEVE_LIMIT) {
+        MPI candidate = start;
+        while (!knuth_prime_test(candidate, ROUNDS)) {
+            candidate += step;
+        }
+        return candidate;
+    }
+
+    if (!threads) {
+        threads = default_threads();
+    }
+
+    Search search(start, step);
+
+    std::vector <std::thread> workers;
+    for(unsigned int i = 1; i < threads; i++) {
+        workers.emplace_back(work, std::ref(search));
+    }
+    work(search);
+
+    for(std::thread & worker : workers) {
+        worker.join();
+    }
+
+    return search.result;
+}
+
+MPI random(const std::size_t bits, unsigned int threads) {
+    if (bits < 3) {
+        throw std::runtime_error("Error: Random primes need at least 3 bits.");
+    }
+
+    while (true) {
+        MPI start = RNG::rand_mpi(bits);
+        mpz_setbit(start.get_mpz_t(), bits - 1);
+        mpz_setbit(start.get_mpz_t(), bits - 2);
+        mpz_setbit(start.get_mpz_t(), 0);
+
+        const MPI prime = progression(start, 2, threads);
+        if (bitsize(prime) == bits) {
+            return prime;
+        }
+    }
+
+    return 0;
+}
+
+}
+}
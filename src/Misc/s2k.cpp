@@ -217,27 +217,45 @@ std::string S2K3::raw() const {
     return std::string(1, type) + std::string(1, hash) + salt + unhexlify(makehex(count, 2));
 }
 
-std::string S2K3::run(const std::string & pass, const std::size_t sym_key_len) const {
-    const std::size_t coded = coded_count(count);
-    const std::string combined = salt + pass;
+namespace {
 
-    const std::size_t digest_octets = Hash::LENGTH.at(hash) >> 3;
-    const std::size_t contexts = (sym_key_len / digest_octets) + (bool) (sym_key_len % digest_octets);
+// one iterated and salted hash context, preloaded with some zeros
+struct Iterate {
+    typedef std::string result_type;
 
-    std::string out = "";
-    for(std::size_t context = 0; context < contexts; context++) {
-        Hash::Instance h = Hash::get_instance(hash, std::string(context, '\x00'));
+    const std::size_t preload;
+    const std::string & combined;
+    const std::size_t coded;
+
+    template <typename H>
+    std::string operator()(H & h) const {
+        h.H::update(std::string(preload, '\x00'));
 
         std::size_t hashed = 0;
         do {
-            h -> update(combined);
+            h.H::update(combined);
             hashed += combined.size();
         } while ((hashed + combined.size()) < coded);
 
         if (hashed < coded) {
-            h -> update(combined.substr(0, coded - hashed));
+            h.H::update(combined.substr(0, coded - hashed));
         }
-        out += h -> digest();
+        return h.digest();
+    }
+};
+
+}
+
+std::string S2K3::run(const std::string & pass, const std::size_t sym_key_len) const {
+    const std::size_t coded = coded_count(count);
+    const std::string combined = salt + pass;
+
+    const std::size_t digest_octets = Hash::length(hash) >> 3;
+    const std::size_t contexts = (sym_key_len / digest_octets) + (bool) (sym_key_len % digest_octets);
+
+    std::string out = "";
+    for(std::size_t context = 0; context < contexts; context++) {
+        out += Hash::dispatch(hash, Iterate{context, combined, coded});
     }
 
     return out.substr(0, sym_key_len);
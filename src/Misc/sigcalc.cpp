@@ -9,16 +9,20 @@
 namespace OpenPGP {
 
 std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig) {
+    return data + gettrailer(sig);
+}
+
+std::string gettrailer(const Packet::Tag2::Ptr & sig) {
     if (!sig) {
         throw std::runtime_error("Error: No signature packet");
     }
 
     const std::string trailer = sig -> get_up_to_hashed();
     if (sig -> get_version() == 3) {
-        return data + trailer.substr(1, trailer.size() - 1); // remove version from trailer
+        return trailer.substr(1, trailer.size() - 1); // remove version from trailer
     }
     else if (sig -> get_version() == 4) {
-        return data + trailer + "\x04\xff" + unhexlify(makehex(trailer.size(), 8));
+        return trailer + "\x04\xff" + unhexlify(makehex(trailer.size(), 8));
     }
     else{
         throw std::runtime_error("Error: addtrailer for version " + std::to_string(sig -> get_version()) + " not defined.");
@@ -120,7 +120,7 @@ Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderForma
             packet_start = pos;
             pos += packet_length;
         }
-        else if ((192 <= first_octet) & (first_octet < 223)) {               // 192 - 8383; A two-octet Body Length header encodes packet lengths of 192 to 8383 octets.
+        else if ((192 <= first_octet) & (first_octet < Packet::PARTIAL_BODY_LENGTH_START)) {               // 192 - 8383; A two-octet Body Length header encodes packet lengths of 192 to 8383 octets.
             hl = read_two_octet_lengths(data, pos, packet_length, format);
             packet_start = pos;
             pos += packet_length;
@@ -163,9 +163,8 @@ Packet::PartialBodyLength PGP::read_packet_unformatted(const Packet::HeaderForma
                 std::cerr << "Warning: Reached end of data, but did not complete partial packet sequence" << std::endl;
             }
             else {
-                // add the final piece
+                // add the final piece (pos is already past it)
                 partial_data += data.substr(final_start, final_length);
-                pos += final_length;
             }
 
             packet_start = 0;
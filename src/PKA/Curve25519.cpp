@@ -0,0 +1,222 @@
+#include "PKA/Curve25519.h"
+
+#include "common/compiler.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace Curve25519 {
+
+namespace {
+
+const uint64_t MASK51 = (static_cast <uint64_t> (1) << 51) - 1;
+
+uint64_t load64(const std::string & s, const std::size_t pos) {
+    uint64_t out = 0;
+    for(std::size_t i = 0; i < 8; i++) {
+        out |= static_cast <uint64_t> (static_cast <uint8_t> (s[pos + i])) << (i << 3);
+    }
+    return out;
+}
+
+// bring every limb back under 2^51 (plus a small amount in limb 0)
+FE carry(const FE & a) {
+    FE r = a;
+    uint64_t c;
+    c = r.v[0] >> 51; r.v[0] &= MASK51; r.v[1] += c;
+    c = r.v[1] >> 51; r.v[1] &= MASK51; r.v[2] += c;
+    c = r.v[2] >> 51; r.v[2] &= MASK51; r.v[3] += c;
+    c = r.v[3] >> 51; r.v[3] &= MASK51; r.v[4] += c;
+    c = r.v[4] >> 51; r.v[4] &= MASK51; r.v[0] += c * 19;
+    return r;
+}
+
+FE carry_wide(uint128_t r0, uint128_t r1, uint128_t r2, uint128_t r3, uint128_t r4) {
+    FE out;
+    r1 += static_cast <uint64_t> (r0 >> 51); out.v[0] = static_cast <uint64_t> (r0) & MASK51;
+    r2 += static_cast <uint64_t> (r1 >> 51); out.v[1] = static_cast <uint64_t> (r1) & MASK51;
+    r3 += static_cast <uint64_t> (r2 >> 51); out.v[2] = static_cast <uint64_t> (r2) & MASK51;
+    r4 += static_cast <uint64_t> (r3 >> 51); out.v[3] = static_cast <uint64_t> (r3) & MASK51;
+    const uint64_t c = static_cast <uint64_t> (r4 >> 51); out.v[4] = static_cast <uint64_t> (r4) & MASK51;
+    out.v[0] += c * 19;
+    out.v[1] += out.v[0] >> 51;
+    out.v[0] &= MASK51;
+    return out;
+}
+
+// a^(2^250 - 1), with a^11 on the side; shared by invert and pow22523
+FE pow2250m1(const FE & a, FE & a11) {
+    const FE a2 = sq(a);
+    const FE a9 = mul(sq(a2, 2), a);
+    a11 = mul(a9, a2);
+    const FE e5   = mul(sq(a11), a9);           // 2^5 - 1
+    const FE e10  = mul(sq(e5, 5), e5);         // 2^10 - 1
+    const FE e20  = mul(sq(e10, 10), e10);      // 2^20 - 1
+    const FE e40  = mul(sq(e20, 20), e20);      // 2^40 - 1
+    const FE e50  = mul(sq(e40, 10), e10);      // 2^50 - 1
+    const FE e100 = mul(sq(e50, 50), e50);      // 2^100 - 1
+    const FE e200 = mul(sq(e100, 100), e100);   // 2^200 - 1
+    return mul(sq(e200, 50), e50);              // 2^250 - 1
+}
+
+}
+
+FE from_int(const uint32_t n) {
+    FE out = {{n, 0, 0, 0, 0}};
+    return out;
+}
+
+FE from_bytes(const std::string & s) {
+    FE out;
+    out.v[0] =  load64(s,  0)        & MASK51;
+    out.v[1] = (load64(s,  6) >>  3) & MASK51;
+    out.v[2] = (load64(s, 12) >>  6) & MASK51;
+    out.v[3] = (load64(s, 19) >>  1) & MASK51;
+    out.v[4] = (load64(s, 24) >> 12) & MASK51;
+    return out;
+}
+
+std::string to_bytes(const FE & f) {
+    FE t = carry(carry(f));
+
+    // t < 2^255 + small, so subtracting p at most once is enough;
+    // q = 1 iff t >= p
+    uint64_t q = (t.v[0] + 19) >> 51;
+    q = (t.v[1] + q) >> 51;
+    q = (t.v[2] + q) >> 51;
+    q = (t.v[3] + q) >> 51;
+    q = (t.v[4] + q) >> 51;
+
+    t.v[0] += 19 * q;
+    t.v[1] += t.v[0] >> 51; t.v[0] &= MASK51;
+    t.v[2] += t.v[1] >> 51; t.v[1] &= MASK51;
+    t.v[3] += t.v[2] >> 51; t.v[2] &= MASK51;
+    t.v[4] += t.v[3] >> 51; t.v[3] &= MASK51;
+    t.v[4] &= MASK51;
+
+    const uint64_t w[4] = {
+         t.v[0]        | (t.v[1] << 51),
+        (t.v[1] >> 13) | (t.v[2] << 38),
+        (t.v[2] >> 26) | (t.v[3] << 25),
+        (t.v[3] >> 39) | (t.v[4] << 12),
+    };
+
+    std::string out(32, 0);
+    for(std::size_t i = 0; i < 32; i++) {
+        out[i] = static_cast <char> (w[i >> 3] >> ((i & 7) << 3));
+    }
+    return out;
+}
+
+FE add(const FE & a, const FE & b) {
+    FE out;
+    for(std::size_t i = 0; i < 5; i++) {
+        out.v[i] = a.v[i] + b.v[i];
+    }
+    return carry(out);
+}
+
+FE sub(const FE & a, const FE & b) {
+    // add 4p first so that no limb goes negative
+    FE out;
+    out.v[0] = (a.v[0] + 0x1FFFFFFFFFFFB4ULL) - b.v[0];
+    for(std::size_t i = 1; i < 5; i++) {
+        out.v[i] = (a.v[i] + 0x1FFFFFFFFFFFFCULL) - b.v[i];
+    }
+    return carry(out);
+}
+
+FE neg(const FE & a) {
+    return sub(from_int(0), a);
+}
+
+FE mul(const FE & a, const FE & b) {
+    const uint64_t b1_19 = b.v[1] * 19;
+    const uint64_t b2_19 = b.v[2] * 19;
+    const uint64_t b3_19 = b.v[3] * 19;
+    const uint64_t b4_19 = b.v[4] * 19;
+
+    const uint128_t r0 = (uint128_t) a.v[0] * b.v[0] + (uint128_t) a.v[1] * b4_19  + (uint128_t) a.v[2] * b3_19  + (uint128_t) a.v[3] * b2_19  + (uint128_t) a.v[4] * b1_19;
+    const uint128_t r1 = (uint128_t) a.v[0] * b.v[1] + (uint128_t) a.v[1] * b.v[0] + (uint128_t) a.v[2] * b4_19  + (uint128_t) a.v[3] * b3_19  + (uint128_t) a.v[4] * b2_19;
+    const uint128_t r2 = (uint128_t) a.v[0] * b.v[2] + (uint128_t) a.v[1] * b.v[1] + (uint128_t) a.v[2] * b.v[0] + (uint128_t) a.v[3] * b4_19  + (uint128_t) a.v[4] * b3_19;
+    const uint128_t r3 = (uint128_t) a.v[0] * b.v[3] + (uint128_t) a.v[1] * b.v[2] + (uint128_t) a.v[2] * b.v[1] + (uint128_t) a.v[3] * b.v[0] + (uint128_t) a.v[4] * b4_19;
+    const uint128_t r4 = (uint128_t) a.v[0] * b.v[4] + (uint128_t) a.v[1] * b.v[3] + (uint128_t) a.v[2] * b.v[2] + (uint128_t) a.v[3] * b.v[1] + (uint128_t) a.v[4] * b.v[0];
+
+    return carry_wide(r0, r1, r2, r3, r4);
+}
+
+FE mul_small(const FE & a, const uint32_t n) {
+    return carry_wide((uint128_t) a.v[0] * n,
+                      (uint128_t) a.v[1] * n,
+                      (uint128_t) a.v[2] * n,
+                      (uint128_t) a.v[3] * n,
+                      (uint128_t) a.v[4] * n);
+}
+
+FE sq(const FE & a) {
+    const uint64_t d0 = a.v[0] * 2;
+    const uint64_t d1 = a.v[1] * 2;
+    const uint64_t d2 = a.v[2] * 2 * 19;
+    const uint64_t d4 = a.v[4] * 19;
+    const uint64_t a3_19 = a.v[3] * 19;
+
+    const uint128_t r0 = (uint128_t) a.v[0] * a.v[0] + (uint128_t) d1 * d4     + (uint128_t) d2 * a.v[3];
+    const uint128_t r1 = (uint128_t) d0 * a.v[1]     + (uint128_t) d2 * a.v[4] + (uint128_t) a.v[3] * a3_19;
+    const uint128_t r2 = (uint128_t) d0 * a.v[2]     + (uint128_t) a.v[1] * a.v[1] + (uint128_t) (a.v[3] * 2) * d4;
+    const uint128_t r3 = (uint128_t) d0 * a.v[3]     + (uint128_t) d1 * a.v[2] + (uint128_t) a.v[4] * d4;
+    const uint128_t r4 = (uint128_t) d0 * a.v[4]     + (uint128_t) d1 * a.v[3] + (uint128_t) a.v[2] * a.v[2];
+
+    return carry_wide(r0, r1, r2, r3, r4);
+}
+
+FE sq(const FE & a, unsigned int n) {
+    FE out = a;
+    while (n--) {
+        out = sq(out);
+    }
+    return out;
+}
+
+FE invert(const FE & a) {
+    FE a11;
+    const FE e250 = pow2250m1(a, a11);
+    return mul(sq(e250, 5), a11);               // 2^255 - 21
+}
+
+FE pow22523(const FE & a) {
+    FE a11;
+    const FE e250 = pow2250m1(a, a11);
+    return mul(sq(e250, 2), a);                 // 2^252 - 3
+}
+
+bool is_zero(const FE & a) {
+    const std::string s = to_bytes(a);
+    uint8_t acc = 0;
+    for(char const & c : s) {
+        acc |= static_cast <uint8_t> (c);
+    }
+    return !acc;
+}
+
+bool is_negative(const FE & a) {
+    return to_bytes(a)[0] & 1;
+}
+
+void cmov(FE & f, const FE & g, const uint64_t b) {
+    const uint64_t mask = -b;
+    for(std::size_t i = 0; i < 5; i++) {
+        f.v[i] ^= (f.v[i] ^ g.v[i]) & mask;
+    }
+}
+
+void cswap(FE & f, FE & g, const uint64_t b) {
+    const uint64_t mask = -b;
+    for(std::size_t i = 0; i < 5; i++) {
+        const uint64_t x = (f.v[i] ^ g.v[i]) & mask;
+        f.v[i] ^= x;
+        g.v[i] ^= x;
+    }
+}
+
+}
+}
+}
@@ -10,26 +10,20 @@ Values new_public(const uint32_t & L, const uint32_t & N) {
 //    L = 2048, N = 256
 //    L = 3072, N = 256
     // random prime q
-    MPI q = bintompi("1" + RNG::RNG().rand_bits(N - 1));
-    q = nextprime(q);
-    while (bitsize(q) > N) {
-        q = bintompi("1" + RNG::RNG().rand_bits(N - 1));
-        q = nextprime(q);
-    }
+    const MPI q = Prime::random(N);
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::RNG().rand_bits(L - 1));              // pick random starting point
+    MPI p = RNG::rand_mpi(L);                                         // pick random starting point
+    mpz_setbit(p.get_mpz_t(), L - 1);
     p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
-    while (!knuth_prime_test(p, 25)) {
-        p += q;
-    }
+    p = Prime::progression(p, q);
 
     // generator g with order q
     MPI g = 1, h = 1;
     MPI exp = (p - 1) / q;
     while (g == 1) {
         h++;
-        g = powm(h, exp, p);
+        g = powm_pub(h, exp, p);
     }
 
     return {p, q, g};
@@ -38,16 +32,13 @@ Values new_public(const uint32_t & L, const uint32_t & N) {
 Values keygen(Values & pub) {
     MPI x = 0;
     std::string test = "testing testing 123"; // a string to test the key with, just in case the key doesn't work for some reason
-    unsigned int bits = bitsize(pub[1]) - 1;
     while (true) {
         // 0 < x < q
-        while ((x == 0) || (pub[1] <= x)) {
-            x = bintompi(RNG::RNG().rand_bits(bits));
-        }
+        x = RNG::rand_range(pub[1]);
 
         // y = g^x mod p
         MPI y;
-        y = powm(pub[2], x, pub[0]);
+        y = powm_sec(pub[2], x, pub[0]);
 
         // public key = p, q, g, y
         // private key = x
@@ -67,19 +58,27 @@ Values keygen(Values & pub) {
     return {x};
 }
 
-Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k) {
+FixedBase::Ptr precompute(const Values & pub) {
+    // k < q
+    return std::make_shared <FixedBase> (pub[2], pub[0], bitsize(pub[1]));
+}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k, const FixedBase::Ptr & g_table) {
+    if (g_table && !g_table -> matches(pub[2], pub[0])) {
+        throw std::runtime_error("Error: Precomputed table does not match DSA parameters.");
+    }
+
     bool set_k = (k == 0);
 
     MPI r = 0, s = 0;
     while ((r == 0) || (s == 0)) {
         // 0 < k < q
         if ( set_k ) {
-            k = bintompi(RNG::RNG().rand_bits(bitsize(pub[1])));
-            k %= pub[1];
+            k = RNG::rand_range(pub[1]);
         }
 
         // r = (g^k mod p) mod q
-        r = powm(pub[2], k, pub[0]);
+        r = g_table?g_table -> powm_sec(k):powm_sec(pub[2], k, pub[0]);
         r %= pub[1];
 
         // if r == 0, don't bother calculating s
@@ -96,8 +95,58 @@ Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k) {
     return {r, s};
 }
 
-Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k) {
-    return sign(rawtompi(data), pri, pub, k);
+Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k, const FixedBase::Ptr & g_table) {
+    return sign(rawtompi(data), pri, pub, k, g_table);
+}
+
+Nonce nonce(const Values & pub, const FixedBase::Ptr & g_table) {
+    if (g_table && !g_table -> matches(pub[2], pub[0])) {
+        throw std::runtime_error("Error: Precomputed table does not match DSA parameters.");
+    }
+
+    MPI k = 0, r = 0;
+    while (r == 0) {
+        // 0 < k < q
+        k = RNG::rand_range(pub[1]);
+
+        // r = (g^k mod p) mod q
+        r = g_table?g_table -> powm_sec(k):powm_sec(pub[2], k, pub[0]);
+        r %= pub[1];
+    }
+
+    const Nonce out = {invert(k, pub[1]), r};
+    mpiwipe(k);
+    return out;
+}
+
+void wipe(Nonce & nonce) {
+    mpiwipe(nonce.k_inv);
+    mpiwipe(nonce.r);
+}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, const Nonce & nonce) {
+    // s = k^-1 (m + x * r) mod q
+    MPI s = (nonce.k_inv * (data + pri[0] * nonce.r)) % pub[1];
+    if (s == 0) {
+        // "Error: Nonce gave s = 0.\n";
+        return {};
+    }
+
+    return {nonce.r, s};
+}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, Pool & pool) {
+    Values sig;
+    while (sig.empty()) {
+        Nonce nonce = pool.take();
+        sig = sign(data, pri, pub, nonce);
+        wipe(nonce);
+    }
+    return sig;
+}
+
+Values sign(const std::string & data, const Values & pri, const Values & pub, Pool & pool) {
+    return sign(rawtompi(data), pri, pub, pool);
 }
 
 bool verify(const MPI & data, const Values & sig, const Values & pub) {
@@ -115,12 +164,10 @@ bool verify(const MPI & data, const Values & sig, const Values & pub) {
     MPI u2 = (sig[0] * w) % pub[1];
 
     // v = ((g ^ u1 * y ^ u2) mod p) mod q
-    MPI g, y;
-    g = powm(pub[2], u1, pub[0]);
-    y = powm(pub[3], u2, pub[0]);
+    const MPI v = powm2_pub(pub[2], u1, pub[3], u2, pub[0]) % pub[1];
 
     // check v == r
-    return ((((g * y) % pub[0]) % pub[1]) == sig[0]);
+    return (v == sig[0]);
 }
 
 bool verify(const std::string & data, const Values & sig, const Values & pub) {
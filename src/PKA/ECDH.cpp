@@ -0,0 +1,125 @@
+#include "PKA/ECDH.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDH {
+
+namespace {
+
+// native point prefix (draft-ietf-openpgp-rfc4880bis sec 13.2)
+const char NATIVE = 0x40;
+
+// public key algorithm ID of ECDH
+const char ALGORITHM = 18;
+
+// u-coordinate octets, or an empty string if the point is malformed
+std::string point(const Values & v) {
+    if (v.size() < 1) {
+        return "";
+    }
+
+    const std::string raw = mpitoraw(v[0]);
+    if ((raw.size() != X25519::SIZE + 1) ||
+        (raw[0] != NATIVE)) {
+        return "";
+    }
+
+    return raw.substr(1);
+}
+
+// key encryption key for the shared secret
+std::string kek(const std::string & Z, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & param) {
+    // all zero means a small order point
+    if (Z == std::string(X25519::SIZE, 0)) {
+        return "";
+    }
+
+    // key wrap needs a 128 bit block cipher
+    if ((Sym::BLOCK_LENGTH.find(kdf_alg) == Sym::BLOCK_LENGTH.end()) ||
+        (Sym::BLOCK_LENGTH.at(kdf_alg) != 128)) {
+        return "";
+    }
+
+    return kdf(kdf_hash, Z, Sym::KEY_LENGTH.at(kdf_alg) >> 3, param);
+}
+
+}
+
+std::string param(const std::string & curve, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & fingerprint) {
+    return std::string(1, curve.size()) + curve +
+           std::string(1, ALGORITHM) +
+           "\x03\x01" + std::string(1, kdf_hash) + std::string(1, kdf_alg) +
+           "Anonymous Sender    " +
+           fingerprint;
+}
+
+std::string kdf(const uint8_t kdf_hash, const std::string & Z, const std::size_t bytes, const std::string & param) {
+    return Hash::use(kdf_hash, std::string("\x00\x00\x00\x01", 4) + Z + param).substr(0, bytes);
+}
+
+Values keygen(Values & pub) {
+    const std::string k = RNG::RNG().rand_bytes(X25519::SIZE);
+    pub = {rawtompi(std::string(1, NATIVE) + X25519::public_key(k))};
+    return {rawtompi(little_end(k, 256))};
+}
+
+Values encrypt(const std::string & data, const Values & pub, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & param, std::string & wrapped) {
+    const std::string U = point(pub);
+    if (!U.size()) {
+        // "Error: Bad ECDH public key.\n";
+        return {};
+    }
+
+    // ephemeral key
+    const std::string v = RNG::RNG().rand_bytes(X25519::SIZE);
+    const std::string V = X25519::public_key(v);
+
+    const std::string key = kek(X25519::scalarmult(v, U), kdf_hash, kdf_alg, param);
+    if (!key.size()) {
+        // "Error: Bad ECDH public key.\n";
+        return {};
+    }
+
+    // RFC 6637 sec 8: PKCS5 padding to a multiple of 8 octets
+    const std::size_t pad = 8 - (data.size() & 7);
+    wrapped = use_key_wrap(kdf_alg, data + std::string(pad, static_cast <char> (pad)), key);
+
+    return {rawtompi(std::string(1, NATIVE) + V)};
+}
+
+std::string decrypt(const Values & c, const std::string & wrapped, const Values & pri, const uint8_t kdf_hash, const uint8_t kdf_alg, const std::string & param) {
+    const std::string V = point(c);
+    if (!V.size() || (pri.size() < 1)) {
+        // "Error: Bad ECDH values.\n";
+        return "";
+    }
+
+    const std::string k = little_end(zfill(mpitoraw(pri[0]), X25519::SIZE, 0), 256);
+    if (k.size() != X25519::SIZE) {
+        return "";
+    }
+
+    const std::string key = kek(X25519::scalarmult(k, V), kdf_hash, kdf_alg, param);
+    if (!key.size()) {
+        return "";
+    }
+
+    const std::string data = use_key_unwrap(kdf_alg, wrapped, key);
+    if (!data.size()) {
+        // "Error: Key unwrap failure.\n";
+        return "";
+    }
+
+    const std::size_t pad = static_cast <uint8_t> (data.back());
+    if ((pad < 1) || (pad > 8) || (pad > data.size()) ||
+        (data.substr(data.size() - pad) != std::string(pad, static_cast <char> (pad)))) {
+        // "Error: Bad padding.\n";
+        return "";
+    }
+
+    return data.substr(0, data.size() - pad);
+}
+
+}
+}
+}
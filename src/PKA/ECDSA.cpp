@@ -0,0 +1,671 @@
+#include "PKA/ECDSA.h"
+
+#include <array>
+#include <vector>
+
+#include "common/compiler.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDSA {
+
+namespace {
+
+// Prime field with N 64 bit limbs, elements kept in Montgomery form
+template <std::size_t N>
+class Field {
+    public:
+        typedef std::array <uint64_t, N> FE;
+
+    private:
+        FE p;
+        uint64_t n0;    // -p^-1 mod 2^64
+        FE r2;          // R^2 mod p
+
+        // (hi, a) mod p, for (hi, a) < 2p
+        FE reduce(const FE & a, const uint64_t hi) const {
+            FE u;
+            uint64_t borrow = 0;
+            for(std::size_t i = 0; i < N; i++) {
+                const uint128_t d = (uint128_t) a[i] - p[i] - borrow;
+                u[i] = static_cast <uint64_t> (d);
+                borrow = static_cast <uint64_t> (d >> 64) & 1;
+            }
+
+            // keep a - p unless it borrowed past the top limb
+            const uint64_t mask = -(hi | (borrow ^ 1));
+            FE out;
+            for(std::size_t i = 0; i < N; i++) {
+                out[i] = (u[i] & mask) | (a[i] & ~mask);
+            }
+            return out;
+        }
+
+    public:
+        FE one;         // R mod p
+
+        static FE limbs(const MPI & a) {
+            FE out = {};
+            std::size_t count = 0;
+            mpz_export(out.data(), &count, -1, sizeof(uint64_t), 0, 0, a.get_mpz_t());
+            return out;
+        }
+
+        static MPI value(const FE & a) {
+            MPI out;
+            mpz_import(out.get_mpz_t(), N, -1, sizeof(uint64_t), 0, 0, a.data());
+            return out;
+        }
+
+        Field(const MPI & prime)
+            : p(limbs(prime)),
+              n0(),
+              r2(limbs((MPI(1) << (128 * N)) % prime)),
+              one(limbs((MPI(1) << (64 * N)) % prime))
+        {
+            uint64_t inv = 1;
+            for(int i = 0; i < 6; i++) {
+                inv *= 2 - p[0] * inv;
+            }
+            n0 = -inv;
+        }
+
+        MPI prime() const {
+            return value(p);
+        }
+
+        // Montgomery multiplication (CIOS)
+        FE mul(const FE & a, const FE & b) const {
+            uint64_t t[N + 2] = {};
+            for(std::size_t i = 0; i < N; i++) {
+                uint64_t carry = 0;
+                for(std::size_t j = 0; j < N; j++) {
+                    const uint128_t x = (uint128_t) a[j] * b[i] + t[j] + carry;
+                    t[j] = static_cast <uint64_t> (x);
+                    carry = static_cast <uint64_t> (x >> 64);
+                }
+                uint128_t x = (uint128_t) t[N] + carry;
+                t[N] = static_cast <uint64_t> (x);
+                t[N + 1] = static_cast <uint64_t> (x >> 64);
+
+                const uint64_t m = t[0] * n0;
+                x = (uint128_t) m * p[0] + t[0];
+                carry = static_cast <uint64_t> (x >> 64);
+                for(std::size_t j = 1; j < N; j++) {
+                    x = (uint128_t) m * p[j] + t[j] + carry;
+                    t[j - 1] = static_cast <uint64_t> (x);
+                    carry = static_cast <uint64_t> (x >> 64);
+                }
+                x = (uint128_t) t[N] + carry;
+                t[N - 1] = static_cast <uint64_t> (x);
+                t[N] = t[N + 1] + static_cast <uint64_t> (x >> 64);
+            }
+
+            FE out;
+            for(std::size_t i = 0; i < N; i++) {
+                out[i] = t[i];
+            }
+            return reduce(out, t[N]);
+        }
+
+        FE sq(const FE & a) const {
+            return mul(a, a);
+        }
+
+        FE add(const FE & a, const FE & b) const {
+            FE out;
+            uint64_t carry = 0;
+            for(std::size_t i = 0; i < N; i++) {
+                const uint128_t s = (uint128_t) a[i] + b[i] + carry;
+                out[i] = static_cast <uint64_t> (s);
+                carry = static_cast <uint64_t> (s >> 64);
+            }
+            return reduce(out, carry);
+        }
+
+        FE sub(const FE & a, const FE & b) const {
+            FE out;
+            uint64_t borrow = 0;
+            for(std::size_t i = 0; i < N; i++) {
+                const uint128_t d = (uint128_t) a[i] - b[i] - borrow;
+                out[i] = static_cast <uint64_t> (d);
+                borrow = static_cast <uint64_t> (d >> 64) & 1;
+            }
+
+            // add p back if it went negative
+            const uint64_t mask = -borrow;
+            uint64_t carry = 0;
+            for(std::size_t i = 0; i < N; i++) {
+                const uint128_t s = (uint128_t) out[i] + (p[i] & mask) + carry;
+                out[i] = static_cast <uint64_t> (s);
+                carry = static_cast <uint64_t> (s >> 64);
+            }
+            return out;
+        }
+
+        FE neg(const FE & a) const {
+            return sub(FE(), a);
+        }
+
+        FE to_mont(const MPI & a) const {
+            return mul(limbs(a % prime()), r2);
+        }
+
+        MPI from_mont(const FE & a) const {
+            FE unit = {};
+            unit[0] = 1;
+            return value(mul(a, unit));
+        }
+
+        // a^(p - 2); the exponent is public so the pattern is fixed
+        FE invert(const FE & a) const {
+            const MPI e = prime() - 2;
+            FE out = one;
+            for(std::size_t i = mpz_sizeinbase(e.get_mpz_t(), 2); i-- > 0;) {
+                out = sq(out);
+                if (mpz_tstbit(e.get_mpz_t(), i)) {
+                    out = mul(out, a);
+                }
+            }
+            return out;
+        }
+
+        static uint64_t is_zero(const FE & a) {
+            uint64_t acc = 0;
+            for(uint64_t const l : a) {
+                acc |= l;
+            }
+            return ((acc | -acc) >> 63) ^ 1;
+        }
+
+        static void cmov(FE & f, const FE & g, const uint64_t b) {
+            const uint64_t mask = -b;
+            for(std::size_t i = 0; i < N; i++) {
+                f[i] ^= (f[i] ^ g[i]) & mask;
+            }
+        }
+};
+
+// interface the ECDSA code needs from a curve, independent of its size
+class Curve {
+    public:
+        virtual ~Curve() {}
+
+        virtual const MPI & order() const = 0;
+        virtual std::size_t bytes() const = 0;
+
+        // y^2 = x^3 - 3x + b with x, y < p
+        virtual bool on_curve(const MPI & x, const MPI & y) const = 0;
+
+        // affine k * G for secret k, 0 < k < n
+        virtual void scalarmult_base(const MPI & k, MPI & x, MPI & y) const = 0;
+
+        // affine x of u1 * G + u2 * Q for public scalars;
+        // false if the result is the point at infinity
+        virtual bool double_scalarmult(const MPI & u1, const MPI & u2, const MPI & Qx, const MPI & Qy, MPI & x) const = 0;
+};
+
+// short Weierstrass curve with a = -3 over an N limb prime field
+template <std::size_t N>
+class Prime : public Curve {
+    private:
+        typedef Field <N> F;
+        typedef typename F::FE FE;
+
+        struct Affine {
+            FE x, y;
+        };
+
+        // Jacobian: x = X / Z^2, y = Y / Z^3; Z = 0 is the point at infinity
+        struct Jacobian {
+            FE X, Y, Z;
+        };
+
+        // comb teeth; the comb table holds 2^TEETH - 1 points
+        static const std::size_t TEETH = 6;
+
+        // window for the wNAF table of G used in verification
+        static const std::size_t G_WINDOW = 7;
+
+        // window for the wNAF table of Q built during verification
+        static const std::size_t Q_WINDOW = 5;
+
+        const F f;
+        const MPI n;
+        const FE b;
+        const Affine G;
+        const std::size_t spacing;                  // comb columns
+        std::vector <Affine> comb;                  // comb[j - 1] = sum of 2^(i * spacing) G for bits i of j
+        std::vector <Affine> G_odd;                 // G, 3G, 5G, ...
+
+        Jacobian infinity() const {
+            const Jacobian out = {f.one, f.one, FE()};
+            return out;
+        }
+
+        Jacobian lift(const Affine & a) const {
+            const Jacobian out = {a.x, a.y, f.one};
+            return out;
+        }
+
+        Affine to_affine(const Jacobian & a) const {
+            const FE zi  = f.invert(a.Z);
+            const FE zi2 = f.sq(zi);
+            const Affine out = {f.mul(a.X, zi2), f.mul(a.Y, f.mul(zi2, zi))};
+            return out;
+        }
+
+        // dbl-2001-b
+        Jacobian dbl(const Jacobian & a) const {
+            const FE delta = f.sq(a.Z);
+            const FE gamma = f.sq(a.Y);
+            const FE beta  = f.mul(a.X, gamma);
+            const FE t     = f.mul(f.sub(a.X, delta), f.add(a.X, delta));
+            const FE alpha = f.add(f.add(t, t), t);
+            const FE beta4 = f.add(f.add(beta, beta), f.add(beta, beta));
+
+            Jacobian out;
+            out.X = f.sub(f.sq(alpha), f.add(beta4, beta4));
+            out.Z = f.sub(f.sub(f.sq(f.add(a.Y, a.Z)), gamma), delta);
+            const FE gamma2 = f.sq(gamma);
+            const FE gamma2_8 = f.add(f.add(f.add(gamma2, gamma2), f.add(gamma2, gamma2)), f.add(f.add(gamma2, gamma2), f.add(gamma2, gamma2)));
+            out.Y = f.sub(f.mul(alpha, f.sub(beta4, out.X)), gamma2_8);
+            return out;
+        }
+
+        // madd-2007-bl without special cases: a != +-b and neither is infinity;
+        // h and r are returned so callers can detect those cases
+        Jacobian madd_generic(const Jacobian & a, const Affine & b, FE & h, FE & r) const {
+            const FE z1z1 = f.sq(a.Z);
+            const FE u2   = f.mul(b.x, z1z1);
+            const FE s2   = f.mul(b.y, f.mul(a.Z, z1z1));
+            h = f.sub(u2, a.X);
+            const FE hh   = f.sq(h);
+            const FE i    = f.add(f.add(hh, hh), f.add(hh, hh));
+            const FE j    = f.mul(h, i);
+            const FE s    = f.sub(s2, a.Y);
+            r = f.add(s, s);
+            const FE v    = f.mul(a.X, i);
+
+            Jacobian out;
+            out.X = f.sub(f.sub(f.sq(r), j), f.add(v, v));
+            const FE y1j = f.mul(a.Y, j);
+            out.Y = f.sub(f.mul(r, f.sub(v, out.X)), f.add(y1j, y1j));
+            out.Z = f.sub(f.sub(f.sq(f.add(a.Z, h)), z1z1), hh);
+            return out;
+        }
+
+        // a + b for public points
+        Jacobian madd(const Jacobian & a, const Affine & b) const {
+            if (F::is_zero(a.Z)) {
+                return lift(b);
+            }
+
+            FE h, r;
+            const Jacobian out = madd_generic(a, b, h, r);
+            if (F::is_zero(h)) {
+                return F::is_zero(r)?dbl(lift(b)):infinity();
+            }
+            return out;
+        }
+
+        // add-2007-bl, for public points
+        Jacobian add(const Jacobian & a, const Jacobian & b) const {
+            if (F::is_zero(a.Z)) {
+                return b;
+            }
+            if (F::is_zero(b.Z)) {
+                return a;
+            }
+
+            const FE z1z1 = f.sq(a.Z);
+            const FE z2z2 = f.sq(b.Z);
+            const FE u1   = f.mul(a.X, z2z2);
+            const FE u2   = f.mul(b.X, z1z1);
+            const FE s1   = f.mul(a.Y, f.mul(b.Z, z2z2));
+            const FE s2   = f.mul(b.Y, f.mul(a.Z, z1z1));
+            const FE h    = f.sub(u2, u1);
+            const FE s    = f.sub(s2, s1);
+            if (F::is_zero(h)) {
+                return F::is_zero(s)?dbl(a):infinity();
+            }
+
+            const FE h2   = f.add(h, h);
+            const FE i    = f.sq(h2);
+            const FE j    = f.mul(h, i);
+            const FE r    = f.add(s, s);
+            const FE v    = f.mul(u1, i);
+
+            Jacobian out;
+            out.X = f.sub(f.sub(f.sq(r), j), f.add(v, v));
+            const FE s1j = f.mul(s1, j);
+            out.Y = f.sub(f.mul(r, f.sub(v, out.X)), f.add(s1j, s1j));
+            out.Z = f.mul(f.sub(f.sub(f.sq(f.add(a.Z, b.Z)), z1z1), z2z2), h);
+            return out;
+        }
+
+        Jacobian negate(const Jacobian & a) const {
+            const Jacobian out = {a.X, f.neg(a.Y), a.Z};
+            return out;
+        }
+
+        Affine negate(const Affine & a) const {
+            const Affine out = {a.x, f.neg(a.y)};
+            return out;
+        }
+
+        // width w non-adjacent form, least significant digit first
+        static std::vector <int> wnaf(MPI k, const std::size_t w) {
+            std::vector <int> out;
+            const long window = 1L << w;
+            while (k > 0) {
+                long d = 0;
+                if (mpz_odd_p(k.get_mpz_t())) {
+                    d = mpz_fdiv_ui(k.get_mpz_t(), window);
+                    if (d >= (window >> 1)) {
+                        d -= window;
+                    }
+                    k -= d;
+                }
+                out.push_back(d);
+                k >>= 1;
+            }
+            return out;
+        }
+
+    public:
+        Prime(const std::string & p_hex, const std::string & b_hex, const std::string & gx_hex, const std::string & gy_hex, const std::string & n_hex)
+            : f(hextompi(p_hex)),
+              n(hextompi(n_hex)),
+              b(f.to_mont(hextompi(b_hex))),
+              G({f.to_mont(hextompi(gx_hex)), f.to_mont(hextompi(gy_hex))}),
+              spacing((64 * N + TEETH - 1) / TEETH),
+              comb(),
+              G_odd()
+        {
+            // teeth: 2^(i * spacing) G
+            std::vector <Jacobian> teeth(TEETH);
+            teeth[0] = lift(G);
+            for(std::size_t i = 1; i < TEETH; i++) {
+                teeth[i] = teeth[i - 1];
+                for(std::size_t j = 0; j < spacing; j++) {
+                    teeth[i] = dbl(teeth[i]);
+                }
+            }
+
+            std::vector <Jacobian> table((1 << TEETH) - 1);
+            for(std::size_t j = 1; j < (1u << TEETH); j++) {
+                std::size_t top = TEETH - 1;
+                while (!((j >> top) & 1)) {
+                    top--;
+                }
+                const std::size_t rest = j ^ (1 << top);
+                table[j - 1] = rest?add(table[rest - 1], teeth[top]):teeth[top];
+            }
+
+            for(Jacobian const & point : table) {
+                comb.push_back(to_affine(point));
+            }
+
+            // G, 3G, 5G, ...
+            const Jacobian G2 = dbl(lift(G));
+            Jacobian odd = lift(G);
+            for(std::size_t i = 0; i < (1u << (G_WINDOW - 2)); i++) {
+                G_odd.push_back(to_affine(odd));
+                odd = add(odd, G2);
+            }
+        }
+
+        const MPI & order() const {
+            return n;
+        }
+
+        std::size_t bytes() const {
+            return 8 * N;
+        }
+
+        bool on_curve(const MPI & x, const MPI & y) const {
+            if ((x < 0) || (y < 0) || (x >= f.prime()) || (y >= f.prime())) {
+                return false;
+            }
+
+            const FE X = f.to_mont(x);
+            const FE rhs = f.add(f.sub(f.mul(f.sq(X), X), f.add(f.add(X, X), X)), b);
+            return f.sq(f.to_mont(y)) == rhs;
+        }
+
+        // comb method: 'spacing' doublings and additions, each addition
+        // taking its point from a full scan of the table
+        void scalarmult_base(const MPI & k, MPI & x, MPI & y) const {
+            const FE digits = F::limbs(k);
+
+            Jacobian R = infinity();
+            for(std::size_t col = spacing; col-- > 0;) {
+                R = dbl(R);
+
+                std::size_t index = 0;
+                for(std::size_t i = 0; i < TEETH; i++) {
+                    const std::size_t bit = i * spacing + col;
+                    if (bit < 64 * N) {
+                        index |= ((digits[bit >> 6] >> (bit & 63)) & 1) << i;
+                    }
+                }
+
+                Affine point = comb[0];
+                for(std::size_t j = 1; j < comb.size(); j++) {
+                    const uint64_t eq = F::is_zero({{static_cast <uint64_t> (index ^ (j + 1))}});
+                    F::cmov(point.x, comb[j].x, eq);
+                    F::cmov(point.y, comb[j].y, eq);
+                }
+
+                // R + point, with R = infinity and index = 0 selected in.
+                // R = +-point needs the two partial scalars to differ by
+                // a multiple of n, which a random k hits with negligible
+                // probability.
+                FE h, r;
+                Jacobian sum = madd_generic(R, point, h, r);
+                const uint64_t r_inf = F::is_zero(R.Z);
+                const Jacobian lifted = lift(point);
+                F::cmov(sum.X, lifted.X, r_inf);
+                F::cmov(sum.Y, lifted.Y, r_inf);
+                F::cmov(sum.Z, lifted.Z, r_inf);
+
+                const uint64_t skip = F::is_zero({{static_cast <uint64_t> (index)}});
+                F::cmov(sum.X, R.X, skip);
+                F::cmov(sum.Y, R.Y, skip);
+                F::cmov(sum.Z, R.Z, skip);
+                R = sum;
+            }
+
+            const Affine a = to_affine(R);
+            x = f.from_mont(a.x);
+            y = f.from_mont(a.y);
+        }
+
+        // interleaved wNAF: one chain of doublings shared by both scalars
+        bool double_scalarmult(const MPI & u1, const MPI & u2, const MPI & Qx, const MPI & Qy, MPI & x) const {
+            const Jacobian Q = {f.to_mont(Qx), f.to_mont(Qy), f.one};
+
+            // Q, 3Q, 5Q, ...
+            std::vector <Jacobian> Q_odd(1 << (Q_WINDOW - 2));
+            const Jacobian Q2 = dbl(Q);
+            Q_odd[0] = Q;
+            for(std::size_t i = 1; i < Q_odd.size(); i++) {
+                Q_odd[i] = add(Q_odd[i - 1], Q2);
+            }
+
+            const std::vector <int> naf1 = wnaf(u1, G_WINDOW);
+            const std::vector <int> naf2 = wnaf(u2, Q_WINDOW);
+
+            Jacobian R = infinity();
+            for(std::size_t i = std::max(naf1.size(), naf2.size()); i-- > 0;) {
+                R = dbl(R);
+
+                const int d1 = (i < naf1.size())?naf1[i]:0;
+                if (d1 > 0) {
+                    R = madd(R, G_odd[d1 >> 1]);
+                }
+                else if (d1 < 0) {
+                    R = madd(R, negate(G_odd[(-d1) >> 1]));
+                }
+
+                const int d2 = (i < naf2.size())?naf2[i]:0;
+                if (d2 > 0) {
+                    R = add(R, Q_odd[d2 >> 1]);
+                }
+                else if (d2 < 0) {
+                    R = add(R, negate(Q_odd[(-d2) >> 1]));
+                }
+            }
+
+            if (F::is_zero(R.Z)) {
+                return false;
+            }
+
+            x = f.from_mont(to_affine(R).x);
+            return true;
+        }
+};
+
+// FIPS 186-4 sec D.1.2
+const std::string P256_OID = "\x2A\x86\x48\xCE\x3D\x03\x01\x07";
+const std::string P384_OID("\x2B\x81\x04\x00\x22", 5);
+
+// tables are built on first use
+const Curve * get(const std::string & curve) {
+    if (curve == P256_OID) {
+        static const Prime <4> p256("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff",
+                                    "5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b",
+                                    "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+                                    "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+                                    "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551");
+        return &p256;
+    }
+    else if (curve == P384_OID) {
+        static const Prime <6> p384("fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff",
+                                    "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875ac656398d8a2ed19d2a85c8edd3ec2aef",
+                                    "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7",
+                                    "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f",
+                                    "ffffffffffffffffffffffffffffffffffffffffffffffffc7634d81f4372ddf581a0db248b0a77aecec196accc52973");
+        return &p384;
+    }
+
+    return nullptr;
+}
+
+// uncompressed point prefix (SEC 1 sec 2.3.3)
+const char UNCOMPRESSED = 0x04;
+
+// public point, checked to be on the curve
+bool point(const Curve & c, const Values & pub, MPI & x, MPI & y) {
+    if (pub.size() < 1) {
+        return false;
+    }
+
+    const std::string raw = mpitoraw(pub[0]);
+    if ((raw.size() != 2 * c.bytes() + 1) ||
+        (raw[0] != UNCOMPRESSED)) {
+        return false;
+    }
+
+    x = rawtompi(raw.substr(1, c.bytes()));
+    y = rawtompi(raw.substr(1 + c.bytes(), c.bytes()));
+    return c.on_curve(x, y);
+}
+
+// leftmost bitsize(n) bits of the digest (FIPS 186-4 sec 6.4)
+MPI truncate(const Curve & c, const std::string & digest) {
+    MPI e = rawtompi(digest);
+    const std::size_t bits = bitsize(c.order());
+    if ((digest.size() << 3) > bits) {
+        e >>= (digest.size() << 3) - bits;
+    }
+    return e;
+}
+
+}
+
+bool supported(const std::string & curve) {
+    return get(curve);
+}
+
+Values keygen(const std::string & curve, Values & pub) {
+    const Curve * c = get(curve);
+    if (!c) {
+        // "Error: Unsupported curve.\n";
+        return {};
+    }
+
+    const MPI d = RNG::rand_range(c -> order());
+    MPI x, y;
+    c -> scalarmult_base(d, x, y);
+    pub = {rawtompi(std::string(1, UNCOMPRESSED) + zfill(mpitoraw(x), c -> bytes(), 0) + zfill(mpitoraw(y), c -> bytes(), 0))};
+    return {d};
+}
+
+Values sign(const std::string & digest, const Values & pri, const Values & pub, const std::string & curve, MPI k) {
+    const Curve * c = get(curve);
+    MPI Qx, Qy;
+    if (!c || (pri.size() < 1) || !point(*c, pub, Qx, Qy)) {
+        // "Error: Bad ECDSA key.\n";
+        return {};
+    }
+
+    const MPI & n = c -> order();
+    const MPI e = truncate(*c, digest);
+    const bool random_k = (k == 0);
+    while (true) {
+        if (random_k) {
+            k = RNG::rand_range(c -> order());
+        }
+        else if (k >= n) {
+            return {};
+        }
+
+        // r = x(k * G) mod n
+        MPI x, y;
+        c -> scalarmult_base(k, x, y);
+        const MPI r = x % n;
+
+        // s = k^-1 (e + d * r) mod n
+        const MPI s = (invert(k, n) * (e + pri[0] * r)) % n;
+
+        if ((r != 0) && (s != 0)) {
+            return {r, s};
+        }
+
+        if (!random_k) {
+            return {};
+        }
+    }
+}
+
+bool verify(const std::string & digest, const Values & sig, const Values & pub, const std::string & curve) {
+    const Curve * c = get(curve);
+    MPI Qx, Qy;
+    if (!c || (sig.size() != 2) || !point(*c, pub, Qx, Qy)) {
+        return false;
+    }
+
+    const MPI & n = c -> order();
+    const MPI & r = sig[0];
+    const MPI & s = sig[1];
+    if ((r <= 0) || (r >= n) || (s <= 0) || (s >= n)) {
+        return false;
+    }
+
+    const MPI w = invert(s, n);
+    const MPI u1 = (truncate(*c, digest) * w) % n;
+    const MPI u2 = (r * w) % n;
+
+    MPI x;
+    if (!c -> double_scalarmult(u1, u2, Qx, Qy, x)) {
+        return false;
+    }
+
+    return (x % n) == r;
+}
+
+}
+}
+}
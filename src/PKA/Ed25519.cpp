@@ -0,0 +1,334 @@
+#include "PKA/Ed25519.h"
+
+#include <stdexcept>
+
+#include "Hashes/Hashes.h"
+#include "Misc/mpi.h"
+#include "PKA/Curve25519.h"
+#include "common/includes.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace Ed25519 {
+
+using namespace Curve25519;
+
+namespace {
+
+// extended coordinates: x = X / Z, y = Y / Z, x * y = T / Z
+struct Point {
+    FE X, Y, Z, T;
+};
+
+// second operand of an addition, with the sums and 2d * T precomputed
+struct Cached {
+    FE YplusX, YminusX, Z, T2d;
+};
+
+// curve constants, computed once
+struct Constants {
+    FE d, d2, sqrtm1;
+    Point B;
+
+    // B_table[i][j] = (j + 1) * 16^i * B
+    Cached B_table[64][8];
+
+    Constants();
+};
+
+// group order
+const MPI & L() {
+    static const MPI l = (MPI(1) << 252) + MPI("27742317777372353535851937790883648493");
+    return l;
+}
+
+// little endian octets <-> MPI
+MPI le_to_mpi(const std::string & s) {
+    return rawtompi(little_end(s, 256));
+}
+
+std::string mpi_to_le(const MPI & a) {
+    return little_end(zfill(mpitoraw(a), 32, 0), 256);
+}
+
+FE from_mpi(const MPI & a) {
+    return from_bytes(mpi_to_le(a));
+}
+
+Point identity() {
+    const Point out = {from_int(0), from_int(1), from_int(1), from_int(0)};
+    return out;
+}
+
+Cached cached_identity() {
+    const Cached out = {from_int(1), from_int(1), from_int(1), from_int(0)};
+    return out;
+}
+
+Cached to_cached(const Point & p, const FE & d2) {
+    const Cached out = {add(p.Y, p.X), sub(p.Y, p.X), p.Z, mul(p.T, d2)};
+    return out;
+}
+
+// add-2008-hwcd-3
+Point point_add(const Point & p, const Cached & q) {
+    const FE a = mul(sub(p.Y, p.X), q.YminusX);
+    const FE b = mul(add(p.Y, p.X), q.YplusX);
+    const FE c = mul(p.T, q.T2d);
+    const FE z = mul(p.Z, q.Z);
+    const FE d = add(z, z);
+    const FE e = sub(b, a);
+    const FE f = sub(d, c);
+    const FE g = add(d, c);
+    const FE h = add(b, a);
+    const Point out = {mul(e, f), mul(g, h), mul(f, g), mul(e, h)};
+    return out;
+}
+
+// dbl-2008-hwcd
+Point point_dbl(const Point & p) {
+    const FE xx = sq(p.X);
+    const FE yy = sq(p.Y);
+    const FE zz = sq(p.Z);
+    const FE e = sub(sq(add(p.X, p.Y)), add(xx, yy));   // 2XY
+    const FE g = sub(yy, xx);
+    const FE f = sub(add(zz, zz), g);
+    const FE h = add(yy, xx);
+    const Point out = {mul(e, f), mul(h, g), mul(g, f), mul(e, h)};
+    return out;
+}
+
+Point negate(const Point & p) {
+    const Point out = {neg(p.X), p.Y, p.Z, neg(p.T)};
+    return out;
+}
+
+std::string encode(const Point & p) {
+    const FE zi = invert(p.Z);
+    const FE x = mul(p.X, zi);
+    const FE y = mul(p.Y, zi);
+    std::string out = to_bytes(y);
+    out[31] |= static_cast <char> (is_negative(x) << 7);
+    return out;
+}
+
+// RFC 8032 sec 5.1.3
+bool decode(const std::string & s, const Constants & c, Point & p) {
+    if (s.size() != 32) {
+        return false;
+    }
+
+    std::string y_bytes = s;
+    const bool x_sign = static_cast <uint8_t> (y_bytes[31]) >> 7;
+    y_bytes[31] &= 0x7f;
+
+    const FE y = from_bytes(y_bytes);
+    if (to_bytes(y) != y_bytes) {               // y >= p
+        return false;
+    }
+
+    // x^2 = (y^2 - 1) / (d y^2 + 1)
+    const FE yy = sq(y);
+    const FE u = sub(yy, from_int(1));
+    const FE v = add(mul(c.d, yy), from_int(1));
+    const FE v3 = mul(sq(v), v);
+    const FE v7 = mul(sq(v3), v);
+    FE x = mul(mul(u, v3), pow22523(mul(u, v7)));
+
+    const FE vxx = mul(v, sq(x));
+    if (!is_zero(sub(vxx, u))) {
+        if (!is_zero(add(vxx, u))) {
+            return false;
+        }
+        x = mul(x, c.sqrtm1);
+    }
+
+    if (is_zero(x) && x_sign) {
+        return false;
+    }
+
+    if (is_negative(x) != x_sign) {
+        x = neg(x);
+    }
+
+    p.X = x;
+    p.Y = y;
+    p.Z = from_int(1);
+    p.T = mul(x, y);
+    return true;
+}
+
+Constants::Constants() {
+    const MPI p = (MPI(1) << 255) - 19;
+    d      = from_mpi((p - 121665) * OpenPGP::invert(121666, p) % p);
+    d2     = add(d, d);
+    sqrtm1 = from_mpi(powm_pub(2, (p - 1) / 4, p));
+
+    // y = 4/5, x positive
+    decode(to_bytes(mul(from_int(4), invert(from_int(5)))), *this, B);
+
+    Point base = B;
+    for(std::size_t i = 0; i < 64; i++) {
+        const Cached c = to_cached(base, d2);
+        Point multiple = base;
+        B_table[i][0] = c;
+        for(std::size_t j = 1; j < 8; j++) {
+            multiple = point_add(multiple, c);
+            B_table[i][j] = to_cached(multiple, d2);
+        }
+
+        for(std::size_t k = 0; k < 4; k++) {
+            base = point_dbl(base);
+        }
+    }
+}
+
+const Constants & constants() {
+    static const Constants c;
+    return c;
+}
+
+// (j + 1) * 16^i * B for |digit| = j + 1, negated if digit < 0,
+// without secret dependent branches or memory access
+Cached select_base(const Constants & c, const std::size_t i, const int8_t digit) {
+    const uint8_t negative = static_cast <uint8_t> (digit) >> 7;
+    const uint8_t abs = digit - ((-negative & digit) << 1);
+
+    Cached out = cached_identity();
+    for(uint8_t j = 0; j < 8; j++) {
+        const uint64_t eq = ((static_cast <uint64_t> (abs ^ (j + 1))) - 1) >> 63;
+        cmov(out.YplusX,  c.B_table[i][j].YplusX,  eq);
+        cmov(out.YminusX, c.B_table[i][j].YminusX, eq);
+        cmov(out.Z,       c.B_table[i][j].Z,       eq);
+        cmov(out.T2d,     c.B_table[i][j].T2d,     eq);
+    }
+
+    cswap(out.YplusX, out.YminusX, negative);
+    cmov(out.T2d, neg(out.T2d), negative);
+    return out;
+}
+
+// a * B for a 32 octet little endian scalar below 2^255
+Point scalarmult_base(const std::string & a) {
+    const Constants & c = constants();
+
+    // signed radix 16 digits in [-8, 8]
+    int8_t e[64];
+    for(std::size_t i = 0; i < 32; i++) {
+        e[2 * i]     = static_cast <uint8_t> (a[i]) & 15;
+        e[2 * i + 1] = static_cast <uint8_t> (a[i]) >> 4;
+    }
+
+    int8_t carry = 0;
+    for(std::size_t i = 0; i < 63; i++) {
+        e[i] += carry;
+        carry = (e[i] + 8) >> 4;
+        e[i] -= carry << 4;
+    }
+    e[63] += carry;
+
+    Point out = identity();
+    for(std::size_t i = 0; i < 64; i++) {
+        out = point_add(out, select_base(c, i, e[i]));
+    }
+    return out;
+}
+
+// a * P for a public scalar; not constant time
+Point scalarmult_vartime(const std::string & a, const Point & p) {
+    const FE & d2 = constants().d2;
+
+    // 0P, 1P, ..., 15P
+    Cached table[16];
+    table[0] = cached_identity();
+    table[1] = to_cached(p, d2);
+    Point multiple = p;
+    for(std::size_t j = 2; j < 16; j++) {
+        multiple = point_add(multiple, table[1]);
+        table[j] = to_cached(multiple, d2);
+    }
+
+    Point out = identity();
+    for(std::size_t i = 64; i-- > 0;) {
+        for(std::size_t k = 0; k < 4; k++) {
+            out = point_dbl(out);
+        }
+
+        const uint8_t nibble = (static_cast <uint8_t> (a[i >> 1]) >> ((i & 1) << 2)) & 15;
+        if (nibble) {
+            out = point_add(out, table[nibble]);
+        }
+    }
+    return out;
+}
+
+// SHA-512 of data reduced mod L, as 32 little endian octets
+std::string hash_mod_L(const std::string & data) {
+    return mpi_to_le(le_to_mpi(Hash::use(Hash::ID::SHA512, data)) % L());
+}
+
+// first half of SHA-512(seed) with the bits RFC 8032 sec 5.1.5 fixes
+std::string clamp(const std::string & h) {
+    std::string a = h.substr(0, 32);
+    a[0]  &= 0xf8;
+    a[31] &= 0x7f;
+    a[31] |= 0x40;
+    return a;
+}
+
+}
+
+std::string public_key(const std::string & seed) {
+    if (seed.size() != SEED_SIZE) {
+        throw std::runtime_error("Error: Ed25519 seed must be 32 octets.");
+    }
+
+    return encode(scalarmult_base(clamp(Hash::use(Hash::ID::SHA512, seed))));
+}
+
+std::string sign(const std::string & message, const std::string & seed, const std::string & pub) {
+    if (seed.size() != SEED_SIZE) {
+        throw std::runtime_error("Error: Ed25519 seed must be 32 octets.");
+    }
+
+    const std::string h = Hash::use(Hash::ID::SHA512, seed);
+    const std::string a = clamp(h);
+    const std::string A = pub.size()?pub:encode(scalarmult_base(a));
+
+    const std::string r = hash_mod_L(h.substr(32, 32) + message);
+    const std::string R = encode(scalarmult_base(r));
+    const std::string k = hash_mod_L(R + A + message);
+
+    // S = (r + k * a) mod L
+    const MPI S = (le_to_mpi(r) + le_to_mpi(k) * le_to_mpi(a)) % L();
+
+    return R + mpi_to_le(S);
+}
+
+bool verify(const std::string & message, const std::string & sig, const std::string & pub) {
+    if ((sig.size() != SIGNATURE_SIZE) ||
+        (pub.size() != PUBLIC_SIZE)) {
+        return false;
+    }
+
+    const std::string R = sig.substr(0, 32);
+    const std::string S = sig.substr(32, 32);
+    if (le_to_mpi(S) >= L()) {
+        return false;
+    }
+
+    Point A;
+    if (!decode(pub, constants(), A)) {
+        return false;
+    }
+
+    const std::string k = hash_mod_L(R + pub + message);
+
+    // R == S * B - k * A
+    const Point check = point_add(scalarmult_base(S), to_cached(scalarmult_vartime(k, negate(A)), constants().d2));
+    return encode(check) == R;
+}
+
+}
+}
+}
@@ -0,0 +1,70 @@
+#include "PKA/EdDSA.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace EdDSA {
+
+namespace {
+
+// 1.3.6.1.4.1.11591.15.1
+const std::string ED25519_OID("\x2B\x06\x01\x04\x01\xDA\x47\x0F\x01", 9);
+
+// native point prefix (draft-ietf-openpgp-rfc4880bis sec 13.2)
+const char NATIVE = 0x40;
+
+// public key octets, or an empty string if the point is malformed
+std::string point(const Values & pub) {
+    if (pub.size() < 1) {
+        return "";
+    }
+
+    const std::string raw = mpitoraw(pub[0]);
+    if ((raw.size() != Ed25519::PUBLIC_SIZE + 1) ||
+        (raw[0] != NATIVE)) {
+        return "";
+    }
+
+    return raw.substr(1);
+}
+
+// MPIs drop leading zeros
+std::string octets(const MPI & a, const std::size_t size) {
+    return zfill(mpitoraw(a), size, 0);
+}
+
+}
+
+bool supported(const std::string & curve) {
+    return curve == ED25519_OID;
+}
+
+Values keygen(Values & pub) {
+    const std::string seed = RNG::RNG().rand_bytes(Ed25519::SEED_SIZE);
+    pub = {rawtompi(std::string(1, NATIVE) + Ed25519::public_key(seed))};
+    return {rawtompi(seed)};
+}
+
+Values sign(const std::string & digest, const Values & pri, const Values & pub) {
+    const std::string A = point(pub);
+    const std::string seed = pri.size()?octets(pri[0], Ed25519::SEED_SIZE):"";
+    if ((seed.size() != Ed25519::SEED_SIZE) || !A.size()) {
+        // "Error: Bad EdDSA key.\n";
+        return {};
+    }
+
+    const std::string sig = Ed25519::sign(digest, seed, A);
+    return {rawtompi(sig.substr(0, 32)), rawtompi(sig.substr(32, 32))};
+}
+
+bool verify(const std::string & digest, const Values & sig, const Values & pub) {
+    const std::string A = point(pub);
+    if ((sig.size() != 2) || !A.size()) {
+        return false;
+    }
+
+    return Ed25519::verify(digest, octets(sig[0], 32) + octets(sig[1], 32), A);
+}
+
+}
+}
+}
@@ -1,6 +1,7 @@
 #include "PKA/ElGamal.h"
 
 #include "Misc/pgptime.h"
+#include "Misc/prime.h"
 #include "RNG/RNGs.h"
 #include "common/includes.h"
 
@@ -11,58 +12,83 @@ namespace ElGamal {
 Values keygen(unsigned int bits) {
     bits /= 5;
     // random prime q - only used for key generation
-    MPI q = bintompi(RNG::RNG().rand_bits(bits));
-    q = nextprime(q);
-    while (bitsize(q) > bits) {
-        q = bintompi(RNG::RNG().rand_bits(bits));
-        q = nextprime(q);
-    }
+    const MPI q = Prime::random(bits);
     bits *= 5;
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::RNG().rand_bits(bits - 1));           // pick random starting point
+    MPI p = RNG::rand_mpi(bits);                                      // pick random starting point
+    mpz_setbit(p.get_mpz_t(), bits - 1);
     p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
-    while (!knuth_prime_test(p, 25)) {
-        p += q;
-    }
+    p = Prime::progression(p, q);
 
     // generator g with order p
     MPI g = 1;
     MPI h = 1;
     MPI exp = (p - 1) / q;
     while (g == 1) {
-        g = powm(++h, exp, p);
+        g = powm_pub(++h, exp, p);
     }
 
     // 0 < x < p
-    MPI x = 0;
-    while ((x == 0) || (p <= x)) {
-        x = bintompi(RNG::RNG().rand_bits(bits));
-    }
+    const MPI x = RNG::rand_range(p);
 
     // y = g^x mod p
     MPI y;
-    y = powm(g, x, p);
+    y = powm_sec(g, x, p);
 
     return {p, g, y, x};
 }
 
-Values encrypt(const MPI & data, const Values & pub) {
-    MPI k = bintompi(RNG::RNG().rand_bits(bitsize(pub[0])));
-    k %= pub[0];
+FixedBase::Ptr precompute(const Values & pub) {
+    // k < p
+    return std::make_shared <FixedBase> (pub[1], pub[0], bitsize(pub[0]));
+}
+
+Nonce nonce(const Values & pub, const FixedBase::Ptr & g_table) {
+    if (g_table && !g_table -> matches(pub[1], pub[0])) {
+        throw std::runtime_error("Error: Precomputed table does not match ElGamal parameters.");
+    }
+
+    // 0 < k < p
+    MPI k = RNG::rand_range(pub[0]);
     MPI r, s;
-    r = powm(pub[1], k, pub[0]);
-    s = powm(pub[2], k, pub[0]);
-    return {r, (data * s) % pub[0]};
+    r = g_table?g_table -> powm_sec(k):powm_sec(pub[1], k, pub[0]);
+    s = powm_sec(pub[2], k, pub[0]);
+    mpiwipe(k);
+    return {r, s};
+}
+
+void wipe(Nonce & nonce) {
+    mpiwipe(nonce.r);
+    mpiwipe(nonce.s);
+}
+
+Values encrypt(const MPI & data, const Values & pub, const FixedBase::Ptr & g_table) {
+    return encrypt(data, pub, nonce(pub, g_table));
+}
+
+Values encrypt(const MPI & data, const Values & pub, const Nonce & nonce) {
+    return {nonce.r, (data * nonce.s) % pub[0]};
+}
+
+Values encrypt(const MPI & data, const Values & pub, Pool & pool) {
+    Nonce nonce = pool.take();
+    const Values out = encrypt(data, pub, nonce);
+    wipe(nonce);
+    return out;
+}
+
+Values encrypt(const std::string & data, const Values & pub, Pool & pool) {
+    return encrypt(rawtompi(data), pub, pool);
 }
 
-Values encrypt(const std::string & data, const Values & pub) {
-    return encrypt(rawtompi(data), pub);
+Values encrypt(const std::string & data, const Values & pub, const FixedBase::Ptr & g_table) {
+    return encrypt(rawtompi(data), pub, g_table);
 }
 
 std::string decrypt(const Values & c, const Values & pri, const Values & pub) {
     MPI s, m;
-    s = powm(c[0], pri[0], pub[0]);
+    s = powm_sec(c[0], pri[0], pub[0]);
     m = invert(s, pub[0]);
     m *= c[1];
     m %= pub[0];
@@ -43,6 +43,7 @@ Params generate_params(const uint8_t pka, const std::size_t bits) {
         case ID::RSA_ENCRYPT_OR_SIGN:
         case ID::RSA_ENCRYPT_ONLY:
         case ID::RSA_SIGN_ONLY:
+            params.push_back(65537);                     // e
             break;
         case ID::ELGAMAL:
             break;
@@ -73,7 +74,7 @@ uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri,
         case ID::RSA_ENCRYPT_OR_SIGN:
         case ID::RSA_ENCRYPT_ONLY:
         case ID::RSA_SIGN_ONLY:
-            pub = RSA::keygen(params[0]);                // n, e, d, p, q, u
+            pub = RSA::keygen(params[0], (params.size() > 1)?params[1]:65537); // n, e, d, p, q, u
             if (!pub.size()) {
                 // "Error: Bad RSA key generation values.\n";
                 return 0;
@@ -4,9 +4,11 @@ namespace OpenPGP {
 namespace PKA {
 namespace RSA {
 
-Values keygen(const uint32_t & bits) {
-    MPI p = 3;
-    MPI q = 3;
+Values keygen(const uint32_t & bits, const MPI & e) {
+    // e must be odd and greater than 1
+    if ((e < 3) || ((e & 1) == 0)) {
+        return {};
+    }
 
     #ifdef GPG_COMPATIBLE
     // gpg only accepts 'n's of certain sizes
@@ -16,62 +18,99 @@ Values keygen(const uint32_t & bits) {
         (nbitsize > 4096)) {    // more than 4096
         return {};
     }
+    #endif
 
-    MPI n;
-    while (true) {
-        p = nextprime(bintompi("1" + RNG::RNG().rand_bits(bits - 1)));
-        q = nextprime(bintompi("1" + RNG::RNG().rand_bits(bits - 1)));
+    // the top two bits of p and q are set, so n always has exactly 2 * bits bits
+    MPI p, q, n, tot;
+    do {
+        p = Prime::random(bits);
+        q = Prime::random(bits);
         n = p * q;
-
-        const std::size_t nbits = bitsize(n);
-        if ((nbits == nbitsize) || (nbits == (nbitsize - 8))) {
-            break;
-        }
-    }
-    #else
-    // don't check bitsize
-    while (p == q) {
-        p = nextprime(bintompi(RNG::RNG().rand_bits(bits)));
-        q = nextprime(bintompi(RNG::RNG().rand_bits(bits)));
-    }
-    const MPI n = p * q;
-    #endif
+        tot = (p - 1) * (q - 1);
+    } while ((p == q) || (mpigcd(tot, e) != 1));  // e is fixed, so pick new primes instead
 
     // required by RFC 4880 sec 5.5.3
     if (p > q) {
         mpiswap(p, q);
     }
 
-    const MPI tot = (p - 1) * (q - 1);
-
-    MPI e = bintompi(RNG::RNG().rand_bits(bits));
-    e += ((e & 1) == 0);
-    while (mpigcd(tot, e) != 1) {
-        e += 2;
-    }
-
     // split this into {n, e} and {d, p, q, u}
     return {n, e, invert(e, tot), p, q, invert(p, q)};
 }
 
 MPI encrypt(const MPI & data, const Values & pub) {
-    return powm(data, pub[1], pub[0]);
+    return powm_pub(data, pub[1], pub[0]);
 }
 
 MPI encrypt(const std::string & data, const Values & pub) {
     return encrypt(rawtompi(data), pub);
 }
 
-MPI decrypt(const MPI & data, const Values & pri, const Values & pub) {
-    return powm(data, pri[0], pub[0]);
+bool has_crt(const Values & pri, const Values & pub) {
+    return (pri.size() >= 4) && pub.size() &&
+           (pri[1] > 1) && (pri[2] > 1) &&
+           ((pri[1] * pri[2]) == pub[0]) &&
+           (((pri[3] * pri[1]) % pri[2]) == 1);
+}
+
+CRT::CRT() :
+    p(), q(),
+    dP(), dQ(),
+    u()
+{}
+
+CRT::CRT(const Values & pri) :
+    p(pri[1]), q(pri[2]),
+    dP(pri[0] % (p - 1)), dQ(pri[0] % (q - 1)),
+    u(pri[3])
+{}
+
+namespace {
+
+// reject results that do not map back to data under the public key
+MPI check(const MPI & out, const MPI & data, const Values & pub, const bool fault_check) {
+    if (fault_check && (encrypt(out, pub) != data)) {
+        throw std::runtime_error("Error: RSA private key operation failed verification.");
+    }
+
+    return out;
+}
+
+}
+
+MPI decrypt(const MPI & data, const Values & pri, const Values & pub, const bool fault_check) {
+    if (has_crt(pri, pub)) {
+        return decrypt(data, CRT(pri), pub, fault_check);
+    }
+
+    return check(powm_sec(data, pri[0], pub[0]), data, pub, fault_check);
+}
+
+MPI decrypt(const MPI & data, const CRT & pri, const Values & pub, const bool fault_check) {
+    // m1 = c^dP mod p, m2 = c^dQ mod q
+    const MPI m1 = powm_sec(data % pri.p, pri.dP, pri.p);
+    const MPI m2 = powm_sec(data % pri.q, pri.dQ, pri.q);
+
+    // h = u * (m2 - m1) mod q
+    MPI h = (pri.u * (m2 - m1)) % pri.q;
+    if (h < 0) {
+        h += pri.q;
+    }
+
+    // m = m1 + h * p
+    return check(m1 + h * pri.p, data, pub, fault_check);
+}
+
+MPI sign(const MPI & data, const Values & pri, const Values & pub, const bool fault_check) {
+    return decrypt(data, pri, pub, fault_check);
 }
 
-MPI sign(const MPI & data, const Values & pri, const Values & pub) {
-    return decrypt(data, pri, pub);
+MPI sign(const MPI & data, const CRT & pri, const Values & pub, const bool fault_check) {
+    return decrypt(data, pri, pub, fault_check);
 }
 
-MPI sign(const std::string & data, const Values & pri, const Values & pub) {
-    return sign(rawtompi(data), pri, pub);
+MPI sign(const std::string & data, const Values & pri, const Values & pub, const bool fault_check) {
+    return sign(rawtompi(data), pri, pub, fault_check);
 }
 
 bool verify(const MPI & data, const Values & signature, const Values & pub) {
@@ -0,0 +1,68 @@
+#include "PKA/X25519.h"
+
+#include <stdexcept>
+
+#include "PKA/Curve25519.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace X25519 {
+
+using namespace Curve25519;
+
+std::string scalarmult(const std::string & k, const std::string & u) {
+    if ((k.size() != SIZE) || (u.size() != SIZE)) {
+        throw std::runtime_error("Error: X25519 inputs must be 32 octets.");
+    }
+
+    std::string scalar = k;
+    scalar[0]  &= 0xf8;
+    scalar[31] &= 0x7f;
+    scalar[31] |= 0x40;
+
+    // Montgomery ladder, RFC 7748 sec 5
+    const FE x1 = from_bytes(u);
+    FE x2 = from_int(1);
+    FE z2 = from_int(0);
+    FE x3 = x1;
+    FE z3 = from_int(1);
+    uint64_t swap = 0;
+
+    for(int t = 254; t >= 0; t--) {
+        const uint64_t k_t = (static_cast <uint8_t> (scalar[t >> 3]) >> (t & 7)) & 1;
+        swap ^= k_t;
+        cswap(x2, x3, swap);
+        cswap(z2, z3, swap);
+        swap = k_t;
+
+        const FE a  = add(x2, z2);
+        const FE aa = sq(a);
+        const FE b  = sub(x2, z2);
+        const FE bb = sq(b);
+        const FE e  = sub(aa, bb);
+        const FE c  = add(x3, z3);
+        const FE d  = sub(x3, z3);
+        const FE da = mul(d, a);
+        const FE cb = mul(c, b);
+
+        x3 = sq(add(da, cb));
+        z3 = mul(x1, sq(sub(da, cb)));
+        x2 = mul(aa, bb);
+        z2 = mul(e, add(aa, mul_small(e, 121665)));
+    }
+
+    cswap(x2, x3, swap);
+    cswap(z2, z3, swap);
+
+    return to_bytes(mul(x2, invert(z2)));
+}
+
+std::string public_key(const std::string & k) {
+    std::string nine(SIZE, 0);
+    nine[0] = 9;
+    return scalarmult(k, nine);
+}
+
+}
+}
+}
@@ -231,11 +231,16 @@ std::string Key::get_fingerprint() const {
             std::string m = write_MPI(i);
             data += m.substr(2, m.size() - 2);
         }
-        return Hash::MD5(data).digest();
+        Hash::Context <Hash::ID::MD5> md5;
+        md5.update(data);
+        return md5.digest();
     }
     else if (version == 4) {
         const std::string packet = raw_common();
-        return Hash::SHA1("\x99" + unhexlify(makehex(packet.size(), 4)) + packet).digest();
+        Hash::Context <Hash::ID::SHA1> sha1;
+        sha1.update("\x99" + unhexlify(makehex(packet.size(), 4)));
+        sha1.update(packet);
+        return sha1.digest();
     }
     else{
         throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
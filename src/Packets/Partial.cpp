@@ -1,6 +1,10 @@
 #include "Packets/Partial.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "Misc/Length.h"
+#include "common/includes.h"
 
 namespace OpenPGP {
 namespace Packet {
@@ -54,5 +58,200 @@ Partial & Partial::operator=(const Partial &copy) {
     return *this;
 }
 
+PartialWriter::PartialWriter(const Output & output, const uint8_t tag, const uint8_t chunk_bits)
+    : out(output),
+      tag(tag),
+      bits(chunk_bits),
+      chunk(0),
+      buffer(),
+      started(false),
+      finished(false)
+{
+    if (!can_have_partial_length(tag)) {
+        throw std::runtime_error("Error: Packet type " + std::to_string(tag) + " cannot have partial body lengths.");
+    }
+
+    if ((chunk_bits < 9) || (30 < chunk_bits)) {
+        throw std::runtime_error("Error: Partial body length must be between 2^9 and 2^30 octets.");
+    }
+
+    chunk = 1UL << bits;
+    buffer.reserve(chunk);
+}
+
+void PartialWriter::write(const std::string & data) {
+    if (finished) {
+        throw std::runtime_error("Error: Packet was already finished.");
+    }
+
+    const uint8_t length = PARTIAL_BODY_LENGTH_START | bits;
+
+    std::string::size_type pos = 0;
+    while (pos < data.size()) {
+        const std::string::size_type take = std::min(chunk - buffer.size(), data.size() - pos);
+        buffer.append(data, pos, take);
+        pos += take;
+
+        if (buffer.size() == chunk) {
+            std::string piece(started?0:1, 0xc0 | tag);
+            piece += std::string(1, length);
+            piece += buffer;
+            out(piece);
+            buffer.clear();
+            started = true;
+        }
+    }
+}
+
+void PartialWriter::finish() {
+    if (finished) {
+        return;
+    }
+
+    // the final length header has no tag octet in front of it
+    const std::string last = write_new_length(tag, buffer, NOT_PARTIAL);
+    out(started?last.substr(1):last);
+    buffer.clear();
+    finished = true;
+}
+
+PacketReader::PacketReader(const Handler & handler)
+    : handler(handler),
+      state(HEADER),
+      tag(0),
+      new_format(true),
+      old_octets(0),
+      length(),
+      remaining(0),
+      partial(false)
+{}
+
+bool PacketReader::read_length() {
+    const uint8_t first = length[0];
+
+    if (!new_format) {
+        if (length.size() < old_octets) {
+            return false;
+        }
+
+        remaining = toint(length, 256);
+        partial = false;
+        return true;
+    }
+
+    // 4.2.2.1.  One-Octet Lengths
+    if (first < 192) {
+        remaining = first;
+        partial = false;
+    }
+    // 4.2.2.2.  Two-Octet Lengths
+    else if (first < PARTIAL_BODY_LENGTH_START) {
+        if (length.size() < 2) {
+            return false;
+        }
+
+        remaining = ((first - 192) << 8) + static_cast <uint8_t> (length[1]) + 192;
+        partial = false;
+    }
+    // 4.2.2.3.  Five-Octet Lengths
+    else if (first == 255) {
+        if (length.size() < 5) {
+            return false;
+        }
+
+        remaining = toint(length.substr(1, 4), 256);
+        partial = false;
+    }
+    // 4.2.2.4.  Partial Body Lengths
+    else {
+        if (!can_have_partial_length(tag)) {
+            throw std::runtime_error("Error: Packet type " + std::to_string(tag) + " cannot have partial body lengths.");
+        }
+
+        remaining = 1ULL << (first & 0x1f);
+        partial = true;
+    }
+
+    return true;
+}
+
+void PacketReader::update(const std::string & data) {
+    std::string::size_type pos = 0;
+    while (pos < data.size()) {
+        switch (state) {
+            case HEADER:
+                {
+                    const uint8_t ctb = data[pos++];
+                    if (!(ctb & 0x80)) {
+                        throw std::runtime_error("Error: First bit of packet header MUST be 1 (0x" + makehex(ctb, 2) + ").");
+                    }
+
+                    length.clear();
+                    new_format = ctb & 0x40;
+                    if (new_format) {
+                        tag = ctb & 0x3f;
+                        state = LENGTH;
+                    }
+                    else {
+                        tag = (ctb >> 2) & 0xf;
+                        if ((ctb & 3) == 3) {
+                            state = REST;
+                        }
+                        else {
+                            old_octets = 1 << (ctb & 3);
+                            state = LENGTH;
+                        }
+                    }
+                }
+                break;
+            case LENGTH:
+                length += data[pos++];
+                if (read_length()) {
+                    length.clear();
+                    if (remaining) {
+                        state = BODY;
+                    }
+                    else {
+                        handler(tag, "", true);
+                        state = HEADER;
+                    }
+                }
+                break;
+            case BODY:
+                {
+                    const std::string::size_type take = std::min <uint64_t> (remaining, data.size() - pos);
+                    remaining -= take;
+                    const bool last = !remaining && !partial;
+                    handler(tag, data.substr(pos, take), last);
+                    pos += take;
+
+                    if (!remaining) {
+                        state = partial?LENGTH:HEADER;
+                    }
+                }
+                break;
+            case REST:
+                handler(tag, data.substr(pos), false);
+                pos = data.size();
+                break;
+        }
+    }
+}
+
+void PacketReader::finish() {
+    if (state == REST) {
+        handler(tag, "", true);
+        state = HEADER;
+    }
+
+    if (state != HEADER) {
+        throw std::runtime_error("Error: Data ended inside of a packet.");
+    }
+}
+
+bool PacketReader::idle() const {
+    return state == HEADER;
+}
+
 }
 }
@@ -4,10 +4,25 @@ namespace OpenPGP {
 namespace Packet {
 
 void Tag1::actual_read(const std::string & data, std::string::size_type & pos, const std::string::size_type & length) {
+    #ifdef GPG_COMPATIBLE
+    const std::string::size_type end = pos + length;
+    #endif
     set_version(data[pos + 0]);
     set_keyid(data.substr(pos + 1, 8));
     set_pka(data[pos + 9]);
     pos += 10;
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH) {
+        mpi.push_back(read_MPI(data, pos));
+        if ((pos >= end) || ((pos + 1 + static_cast <uint8_t> (data[pos])) > end)) {
+            throw std::runtime_error("Error: ECDH wrapped session key is truncated.");
+        }
+        const uint8_t size = data[pos];
+        wrapped = data.substr(pos + 1, size);
+        pos += size + 1;
+        return;
+    }
+    #endif
     while (pos < length) {
         mpi.push_back(read_MPI(data, pos));
     }
@@ -24,6 +39,12 @@ void Tag1::show_contents(HumanReadable & hr) const {
         hr << "ELGAMAL g**k mod p (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
            << "ELGAMAL m * y**k mod p (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDH) {
+        hr << "ECDH ephemeral point (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
+           << "ECDH wrapped key (" + std::to_string(wrapped.size()) + " octets): " + hexlify(wrapped);
+    }
+    #endif
 }
 
 std::string Tag1::actual_raw() const {
@@ -31,6 +52,11 @@ std::string Tag1::actual_raw() const {
     for(unsigned int x = 0; x < mpi.size(); x++) {
         out += write_MPI(mpi[x]);
     }
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH) {
+        out += std::string(1, wrapped.size()) + wrapped;
+    }
+    #endif
     return out;
 }
 
@@ -63,7 +89,7 @@ Status Tag1::actual_valid(const bool check_mpi) const {
                 break;
             #ifdef GPG_COMPATIBLE
             case PKA::ID::ECDH:
-                valid_mpi = (mpi.size() == 1);
+                valid_mpi = (mpi.size() == 1) && wrapped.size() && (wrapped.size() < 256);
                 break;
             #endif
             default:
@@ -82,7 +108,8 @@ Tag1::Tag1()
     : Tag(PUBLIC_KEY_ENCRYPTED_SESSION_KEY, 3),
       keyid(),
       pka(),
-      mpi()
+      mpi(),
+      wrapped()
 {}
 
 Tag1::Tag1(const std::string & data)
@@ -103,6 +130,10 @@ PKA::Values Tag1::get_mpi() const {
     return mpi;
 }
 
+std::string Tag1::get_wrapped() const {
+    return wrapped;
+}
+
 void Tag1::set_keyid(const std::string & k) {
     keyid = k;
 }
@@ -115,6 +146,10 @@ void Tag1::set_mpi(const PKA::Values & m) {
     mpi = m;
 }
 
+void Tag1::set_wrapped(const std::string & w) {
+    wrapped = w;
+}
+
 Tag::Ptr Tag1::clone() const {
     return std::make_shared <Packet::Tag1> (*this);
 }
@@ -17,7 +17,7 @@ std::string Tag19::actual_raw() const {
 }
 
 Status Tag19::actual_valid(const bool) const {
-    if (hash.size() != (Hash::LENGTH.at(Hash::ID::SHA1) >> 3)) {
+    if (hash.size() != (Hash::Traits <Hash::ID::SHA1>::LENGTH >> 3)) {
         return Status::INVALID_SHA1_HASH;
     }
 
@@ -28,7 +28,7 @@ Tag19::Tag19()
     : Tag(MODIFICATION_DETECTION_CODE),
       hash()
 {
-    size = Hash::LENGTH.at(Hash::ID::SHA1) >> 3;
+    size = Hash::Traits <Hash::ID::SHA1>::LENGTH >> 3;
 }
 
 Tag19::Tag19(const std::string & data)
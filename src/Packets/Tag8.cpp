@@ -7,7 +7,7 @@ namespace OpenPGP {
 namespace Packet {
 
 std::string Tag8::compress(const std::string & data) const {
-    return Compression::compress(comp, data);
+    return Compression::compress(comp, data, level, strategy);
 }
 
 std::string Tag8::decompress(const std::string & data) const {
@@ -38,7 +38,7 @@ void Tag8::show_contents(HumanReadable & hr) const {
 }
 
 std::string Tag8::actual_raw() const {
-    return std::string(1, comp) + compressed_data;
+    return std::string(1, comp) + get_compressed_data();
 }
 
 std::string Tag8::actual_write() const {
@@ -57,7 +57,12 @@ Tag8::Tag8(const PartialBodyLength & part)
     : Tag(COMPRESSED_DATA, 3),
       Partial(part),
       comp(Compression::ID::UNCOMPRESSED),
-      compressed_data()
+      level(Z_DEFAULT_COMPRESSION),
+      strategy(Z_DEFAULT_STRATEGY),
+      compressed_data(),
+      data(),
+      have_compressed(true),
+      have_data(true)
 {}
 
 Tag8::Tag8(const std::string & data)
@@ -78,8 +83,30 @@ uint8_t Tag8::get_comp() const {
     return comp;
 }
 
+int Tag8::get_level() const {
+    return level;
+}
+
+int Tag8::get_strategy() const {
+    return strategy;
+}
+
 std::string Tag8::get_data() const {
-    return decompress(compressed_data);
+    if (!have_data) {
+        data = decompress(compressed_data);
+        have_data = true;
+    }
+    return data;
+}
+
+Status Tag8::get_data(const Compression::Sink & sink, const Compression::Budget & budget) const {
+    if (!have_compressed) {
+        // data set locally is not compressed yet, so it cannot expand
+        Compression::BudgetedDecompressor passthrough(Compression::ID::UNCOMPRESSED, budget);
+        return passthrough.feed(data, sink);
+    }
+
+    return Compression::decompress(comp, compressed_data, sink, budget);
 }
 
 Message Tag8::get_body() const {
@@ -89,18 +116,56 @@ Message Tag8::get_body() const {
 }
 
 std::string Tag8::get_compressed_data() const {
+    if (!have_compressed) {
+        compressed_data = compress(data);
+        have_compressed = true;
+    }
     return compressed_data;
 }
 
 void Tag8::set_comp(const uint8_t alg) {
-    // recompress data
-    const std::string data = get_data();// decompress data
-    comp = alg;                         // set new compression algorithm
-    set_data(data);                     // compress data with new algorithm
+    if (alg == comp) {
+        return;
+    }
+
+    get_data();                         // decompress with the old algorithm
+    comp = alg;
+    compressed_data.clear();            // compress with the new algorithm when needed
+    have_compressed = false;
+}
+
+void Tag8::set_level(const int l) {
+    if (l == level) {
+        return;
+    }
+
+    get_data();
+    level = l;
+    compressed_data.clear();
+    have_compressed = false;
+}
+
+void Tag8::set_strategy(const int s) {
+    if (s == strategy) {
+        return;
+    }
+
+    get_data();
+    strategy = s;
+    compressed_data.clear();
+    have_compressed = false;
 }
 
 void Tag8::set_data(const std::string & data) {
-    compressed_data = compress(data);
+    // the same data keeps its compressed form
+    if (have_data && (this -> data == data)) {
+        return;
+    }
+
+    this -> data = data;
+    have_data = true;
+    compressed_data.clear();
+    have_compressed = false;
 }
 
 void Tag8::set_body(const Message & msg) {
@@ -110,6 +175,9 @@ void Tag8::set_body(const Message & msg) {
 
 void Tag8::set_compressed_data(const std::string & data) {
     compressed_data = data;
+    have_compressed = true;
+    this -> data.clear();
+    have_data = false;
 }
 
 Tag::Ptr Tag8::clone() const {
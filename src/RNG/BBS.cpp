@@ -1,5 +1,6 @@
 #include "RNG/BBS.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "common/cryptomath.h"
@@ -15,9 +16,12 @@ MPI BBS::state = 0;
 
 MPI BBS::m = 0;
 
+std::mutex BBS::mutex;
+
 const MPI BBS::two = 2;
 
 void BBS::init(const MPI & seed, const unsigned int & bits, MPI p, MPI q) {
+    std::lock_guard <std::mutex> lock(mutex);
     if (!seeded) {
         /*
         p and q should be:
@@ -83,9 +87,16 @@ BBS::BBS(const MPI & SEED, const unsigned int & bits, MPI p, MPI q)
     init(SEED, bits, p, q);
 }
 
+void BBS::fill(void * buf, const std::size_t len, const std::string & par) {
+    const std::string bytes = rand_bytes(len, par);
+    std::copy(bytes.begin(), bytes.end(), static_cast <char *> (buf));
+}
+
 std::string BBS::rand_bits(const unsigned int & bits, const std::string & par) {
     BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
 
+    std::lock_guard <std::mutex> lock(mutex);
+
     // returns string because SIZE might be larger than 64 bits
     std::string out(bits, '0');
     for(char & c : out) {
@@ -0,0 +1,261 @@
+#include "RNG/ChaCha20.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "Hashes/Hashes.h"
+#include "common/includes.h"
+
+namespace OpenPGP {
+namespace RNG {
+
+namespace {
+
+uint32_t rotl(const uint32_t x, const unsigned int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+void quarter_round(uint32_t * x, const std::size_t a, const std::size_t b, const std::size_t c, const std::size_t d) {
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a],  8);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c],  7);
+}
+
+uint32_t load32(const unsigned char * p) {
+    return  static_cast <uint32_t> (p[0])        |
+           (static_cast <uint32_t> (p[1]) <<  8) |
+           (static_cast <uint32_t> (p[2]) << 16) |
+           (static_cast <uint32_t> (p[3]) << 24);
+}
+
+void store32(unsigned char * p, const uint32_t x) {
+    p[0] = static_cast <unsigned char> (x);
+    p[1] = static_cast <unsigned char> (x >>  8);
+    p[2] = static_cast <unsigned char> (x >> 16);
+    p[3] = static_cast <unsigned char> (x >> 24);
+}
+
+// RFC 8439 sec 2.3
+void chacha20_block(const uint32_t key[8], const uint32_t counter, const uint32_t nonce[3], unsigned char out[64]) {
+    const uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3],
+        key[4], key[5], key[6], key[7],
+        counter, nonce[0], nonce[1], nonce[2],
+    };
+
+    uint32_t x[16];
+    std::memcpy(x, in, sizeof(x));
+    for(int i = 0; i < 10; i++) {
+        quarter_round(x, 0, 4,  8, 12);
+        quarter_round(x, 1, 5,  9, 13);
+        quarter_round(x, 2, 6, 10, 14);
+        quarter_round(x, 3, 7, 11, 15);
+        quarter_round(x, 0, 5, 10, 15);
+        quarter_round(x, 1, 6, 11, 12);
+        quarter_round(x, 2, 7,  8, 13);
+        quarter_round(x, 3, 4,  9, 14);
+    }
+
+    for(std::size_t i = 0; i < 16; i++) {
+        store32(out + 4 * i, x[i] + in[i]);
+    }
+}
+
+// fill buf with octets from the operating system
+void os_random(unsigned char * buf, std::size_t len) {
+    #if defined(__linux__) && defined(SYS_getrandom)
+    while (len) {
+        const long got = syscall(SYS_getrandom, buf, len, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;                                  // ENOSYS: fall back to /dev/urandom
+        }
+        buf += got;
+        len -= got;
+    }
+    #endif
+
+    if (len) {
+        std::ifstream urandom("/dev/urandom", std::ios::binary);
+        if (!urandom.read(reinterpret_cast <char *> (buf), len)) {
+            throw std::runtime_error("Error: Could not get " + std::to_string(len) + " random octets from the operating system.");
+        }
+    }
+}
+
+// keystream blocks generated under one key before it is replaced
+const std::size_t MAX_BLOCKS = 16;
+
+// incremented in the child after every fork()
+std::atomic <unsigned int> forks(0);
+
+void atfork_child() {
+    forks++;
+}
+
+std::once_flag atfork_registered;
+
+// generator state of one thread
+struct State {
+    uint32_t key[8];
+    unsigned char buffer[ChaCha20::BUFFER_SIZE];
+    std::size_t available;                      // unread octets at the end of buffer
+    uint64_t output;                            // octets produced since the last reseed
+    unsigned int forks;                         // value of forks when seeded
+    bool seeded;
+
+    State()
+        : key(),
+          buffer(),
+          available(0),
+          output(0),
+          forks(0),
+          seeded(false)
+    {}
+
+    ~State() {
+        std::memset(key, 0, sizeof(key));
+        std::memset(buffer, 0, sizeof(buffer));
+    }
+};
+
+thread_local State state;
+
+void reseed(State & s, const std::string & extra) {
+    std::call_once(atfork_registered, [](){ pthread_atfork(nullptr, nullptr, atfork_child); });
+
+    unsigned char fresh[32];
+    os_random(fresh, sizeof(fresh));
+
+    std::string current(32, 0);
+    for(std::size_t i = 0; i < 8; i++) {
+        store32(reinterpret_cast <unsigned char *> (&current[4 * i]), s.key[i]);
+    }
+
+    // new key = SHA-256(old key || OS entropy || caller entropy)
+    const std::string digest = Hash::use(Hash::ID::SHA256, current + std::string(reinterpret_cast <char *> (fresh), sizeof(fresh)) + extra);
+    for(std::size_t i = 0; i < 8; i++) {
+        s.key[i] = load32(reinterpret_cast <const unsigned char *> (&digest[4 * i]));
+    }
+
+    // buffered octets came from the old key (and the parent, after fork())
+    std::memset(s.buffer, 0, sizeof(s.buffer));
+    s.available = 0;
+    s.output = 0;
+    s.forks = forks;
+    s.seeded = true;
+}
+
+// fill out with keystream, replacing the key at least every MAX_BLOCKS blocks
+void keystream(State & s, unsigned char * out, std::size_t len) {
+    static const uint32_t nonce[3] = {0, 0, 0};
+    unsigned char stream[64 * MAX_BLOCKS];
+    while (len) {
+        // 32 octets for the next key, then up to the rest of the blocks
+        const std::size_t take = std::min(len, sizeof(stream) - 32);
+        const std::size_t blocks = (take + 32 + 63) >> 6;
+        for(std::size_t i = 0; i < blocks; i++) {
+            chacha20_block(s.key, i, nonce, stream + 64 * i);
+        }
+
+        for(std::size_t i = 0; i < 8; i++) {
+            s.key[i] = load32(stream + 4 * i);
+        }
+        std::memcpy(out, stream + 32, take);
+
+        out += take;
+        len -= take;
+    }
+
+    std::memset(stream, 0, sizeof(stream));
+}
+
+void generate(State & s, unsigned char * out, std::size_t len) {
+    if (!s.seeded || (s.forks != forks) || (s.output >= ChaCha20::RESEED_INTERVAL)) {
+        reseed(s, "");
+    }
+    s.output += len;
+
+    // large requests skip the buffer
+    if (len > ChaCha20::BUFFER_SIZE) {
+        keystream(s, out, len);
+        return;
+    }
+
+    while (len) {
+        if (!s.available) {
+            keystream(s, s.buffer, ChaCha20::BUFFER_SIZE);
+            s.available = ChaCha20::BUFFER_SIZE;
+        }
+
+        const std::size_t take = std::min(len, s.available);
+        unsigned char * src = s.buffer + ChaCha20::BUFFER_SIZE - s.available;
+        std::memcpy(out, src, take);
+        std::memset(src, 0, take);
+        s.available -= take;
+
+        out += take;
+        len -= take;
+    }
+}
+
+}
+
+std::string ChaCha20::block(const std::string & key, const uint32_t counter, const std::string & nonce) {
+    if ((key.size() != 32) || (nonce.size() != 12)) {
+        throw std::runtime_error("Error: ChaCha20 needs a 32 octet key and a 12 octet nonce.");
+    }
+
+    uint32_t k[8], n[3];
+    for(std::size_t i = 0; i < 8; i++) {
+        k[i] = load32(reinterpret_cast <const unsigned char *> (&key[4 * i]));
+    }
+    for(std::size_t i = 0; i < 3; i++) {
+        n[i] = load32(reinterpret_cast <const unsigned char *> (&nonce[4 * i]));
+    }
+
+    unsigned char out[64];
+    chacha20_block(k, counter, n, out);
+    return std::string(reinterpret_cast <char *> (out), sizeof(out));
+}
+
+ChaCha20::ChaCha20() {}
+
+ChaCha20::ChaCha20(const std::string & seed) {
+    reseed(state, seed);
+}
+
+void ChaCha20::fill(void * buf, const std::size_t len) {
+    if (len) {
+        generate(state, static_cast <unsigned char *> (buf), len);
+    }
+}
+
+std::string ChaCha20::rand_bits(const unsigned int & bits) {
+    return binify(rand_bytes((bits + 7) >> 3)).substr(0, bits);
+}
+
+std::string ChaCha20::rand_bytes(const unsigned int & bytes) {
+    std::string out(bytes, 0);
+    fill(&out[0], bytes);
+    return out;
+}
+
+}
+}
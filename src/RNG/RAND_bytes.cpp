@@ -32,27 +32,27 @@ RAND_bytes::RAND_bytes(const void * buf, int num) {
     seed(buf, num);
 }
 
-std::string RAND_bytes::rand_bits(const unsigned int & bits, const std::size_t max_attempts) {
-    return binify(rand_bytes((bits >> 3) + (bool) (bits & 0xff), max_attempts)).substr(0, bits);
-}
-
-std::string RAND_bytes::rand_bytes(const unsigned int & bytes, const std::size_t max_attempts) {
+void RAND_bytes::fill(void * buf, const std::size_t len, const std::size_t max_attempts) {
     RAND_bytes();
 
-    unsigned char * buf = new unsigned char[bytes];
-
     std::size_t attempt = 0;
-    while ((attempt < max_attempts) && (::RAND_bytes(buf, bytes) != 1)) {
+    while ((attempt < max_attempts) && (::RAND_bytes(static_cast <unsigned char *> (buf), static_cast <int> (len)) != 1)) {
         attempt++;
     }
 
     if (attempt == max_attempts) {
-        throw std::runtime_error("Could not get " + std::to_string(bytes) + " random bytes after " + std::to_string(max_attempts) + " attempts");
+        throw std::runtime_error("Could not get " + std::to_string(len) + " random bytes after " + std::to_string(max_attempts) + " attempts");
     }
+}
 
-    const std::string ret((char *) buf, bytes);
-    delete [] buf;
-    return ret;
+std::string RAND_bytes::rand_bits(const unsigned int & bits, const std::size_t max_attempts) {
+    return binify(rand_bytes((bits + 7) >> 3, max_attempts)).substr(0, bits);
+}
+
+std::string RAND_bytes::rand_bytes(const unsigned int & bytes, const std::size_t max_attempts) {
+    std::string out(bytes, 0);
+    fill(&out[0], bytes, max_attempts);
+    return out;
 }
 
 }
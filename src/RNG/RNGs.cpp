@@ -0,0 +1,46 @@
+#include "RNG/RNGs.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace OpenPGP {
+namespace RNG {
+
+MPI rand_mpi(const unsigned int bits) {
+    std::vector <unsigned char> buf((bits + 7) >> 3);
+    if (buf.empty()) {
+        return 0;
+    }
+
+    RNG().fill(buf.data(), buf.size());
+
+    // drop the extra high bits of the first octet
+    if (bits & 7) {
+        buf[0] &= (1 << (bits & 7)) - 1;
+    }
+
+    MPI out;
+    mpz_import(out.get_mpz_t(), buf.size(), 1, 1, 0, 0, buf.data());
+    std::fill(buf.begin(), buf.end(), 0);
+    return out;
+}
+
+MPI rand_range(const MPI & q) {
+    if (q <= 1) {
+        throw std::runtime_error("Error: Random range [1, q) is empty.");
+    }
+
+    // rejection sampling keeps the result uniform; each draw is
+    // accepted with probability over 1/2
+    const unsigned int bits = bitsize(q);
+    while (true) {
+        const MPI out = rand_mpi(bits);
+        if ((out != 0) && (out < q)) {
+            return out;
+        }
+    }
+}
+
+}
+}
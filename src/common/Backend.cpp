@@ -0,0 +1,56 @@
+#include "common/Backend.h"
+
+#include <atomic>
+
+namespace OpenPGP {
+namespace Backend {
+
+namespace {
+
+#if defined(OPENSSL_HASH) || defined(OPENSSL_SYM)
+constexpr uint8_t DEFAULT = ID::OPENSSL;
+#else
+constexpr uint8_t DEFAULT = ID::BUILTIN;
+#endif
+
+// constant initialized inside of a function, so hashes and ciphers
+// created during static initialization of other files see the default
+std::atomic <uint8_t> & selected() {
+    static std::atomic <uint8_t> backend(DEFAULT);
+    return backend;
+}
+
+}
+
+bool available(const uint8_t backend) {
+    switch (backend) {
+        case ID::BUILTIN:
+            return true;
+        case ID::OPENSSL:
+            #if defined(OPENSSL_HASH) || defined(OPENSSL_SYM)
+            return true;
+            #else
+            return false;
+            #endif
+        default:
+            break;
+    }
+
+    return false;
+}
+
+bool set(const uint8_t backend) {
+    if (!available(backend)) {
+        return false;
+    }
+
+    selected() = backend;
+    return true;
+}
+
+uint8_t get() {
+    return selected();
+}
+
+}
+}
@@ -0,0 +1,127 @@
+#include "common/Input.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OpenPGP {
+
+namespace {
+
+// octets per pread(2) when fd is not mapped
+const std::size_t BUFFER_SIZE = 1 << 22;
+
+std::runtime_error read_error(const int fd) {
+    return std::runtime_error("Error: Could not read from file descriptor " + std::to_string(fd) + ": " + std::strerror(errno));
+}
+
+// false if the file could not be mapped, before input is called
+bool from_map(const int fd, const std::size_t size, const Input & input) {
+    if (!size) {
+        return true;
+    }
+
+    void * map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    // only advice, so failure does not matter
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    try {
+        input(static_cast <const char *> (map), size);
+    }
+    catch (...) {
+        munmap(map, size);
+        throw;
+    }
+
+    munmap(map, size);
+    return true;
+}
+
+// fill buffer starting at offset; returns the number of octets read, 0 at the end
+std::size_t fill(const int fd, std::vector <char> & buffer, const off_t offset, const bool seekable) {
+    std::size_t got = 0;
+    while (got < buffer.size()) {
+        const ssize_t rc = seekable?pread(fd, &buffer[got], buffer.size() - got, offset + got)
+                                   :read(fd, &buffer[got], buffer.size() - got);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw read_error(fd);
+        }
+
+        if (!rc) {
+            break;
+        }
+
+        got += rc;
+    }
+
+    return got;
+}
+
+void from_reads(const int fd, const bool seekable, const Input & input) {
+    std::vector <char> buffers[2] = {std::vector <char> (BUFFER_SIZE), std::vector <char> (BUFFER_SIZE)};
+    std::size_t current = 0;
+    off_t offset = 0;
+
+    std::size_t got = fill(fd, buffers[current], offset, seekable);
+    while (got) {
+        offset += got;
+
+        // read the next piece while input handles this one
+        // (the future waits for the read if input throws)
+        std::future <std::size_t> next = std::async(std::launch::async, fill, fd, std::ref(buffers[current ^ 1]), offset, seekable);
+        input(buffers[current].data(), got);
+        got = next.get();
+        current ^= 1;
+    }
+}
+
+}
+
+void from_fd(const int fd, const Input & input) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        throw read_error(fd);
+    }
+
+    if (S_ISREG(st.st_mode) &&
+        (static_cast <uint64_t> (st.st_size) <= SIZE_MAX) &&
+        from_map(fd, st.st_size, input)) {
+        return;
+    }
+
+    from_reads(fd, lseek(fd, 0, SEEK_CUR) != -1, input);
+}
+
+void from_file(const std::string & filename, const Input & input) {
+    const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Error: Could not open " + filename + ": " + std::strerror(errno));
+    }
+
+    try {
+        from_fd(fd, input);
+    }
+    catch (...) {
+        close(fd);
+        throw;
+    }
+
+    close(fd);
+}
+
+}
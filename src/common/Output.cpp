@@ -0,0 +1,37 @@
+#include "common/Output.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace OpenPGP {
+
+Output to_stream(std::ostream & stream) {
+    return [&stream](const std::string & data) {
+        if (!stream.write(data.data(), data.size())) {
+            throw std::runtime_error("Error: Could not write to output stream.");
+        }
+    };
+}
+
+Output to_fd(const int fd) {
+    return [fd](const std::string & data) {
+        const char * buf = data.data();
+        std::size_t len = data.size();
+        while (len) {
+            const ssize_t rc = ::write(fd, buf, len);
+            if (rc < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Error: Could not write to file descriptor " + std::to_string(fd) + ": " + std::strerror(errno));
+            }
+            buf += rc;
+            len -= rc;
+        }
+    };
+}
+
+}
@@ -0,0 +1,110 @@
+#include "common/ThreadPool.h"
+
+namespace OpenPGP {
+
+namespace {
+
+// pool that owns the current thread, if any
+thread_local const ThreadPool * current = nullptr;
+
+}
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : workers(),
+      tasks(),
+      mutex(),
+      available(),
+      idle(),
+      running(0),
+      stopping(false),
+      error(nullptr)
+{
+    if (!threads) {
+        threads = std::thread::hardware_concurrency();
+    }
+
+    if (!threads) {
+        threads = 1;
+    }
+
+    workers.reserve(threads);
+    for(std::size_t i = 0; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+
+    for(std::thread & worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::work() {
+    current = this;
+
+    while (true) {
+        Task task;
+        {
+            std::unique_lock <std::mutex> lock(mutex);
+            available.wait(lock, [this]{ return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;                 // stopping and nothing left to run
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            running++;
+        }
+
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard <std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard <std::mutex> lock(mutex);
+            running--;
+        }
+        idle.notify_all();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+bool ThreadPool::in_worker() const {
+    return current == this;
+}
+
+void ThreadPool::submit(const Task & task) {
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+    available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock <std::mutex> lock(mutex);
+    idle.wait(lock, [this]{ return tasks.empty() && !running; });
+
+    if (error) {
+        std::exception_ptr rethrow = error;
+        error = nullptr;
+        std::rethrow_exception(rethrow);
+    }
+}
+
+}
@@ -1,5 +1,9 @@
 #include "decrypt.h"
 
+#include <algorithm>
+#include <istream>
+#include <stdexcept>
+
 namespace OpenPGP {
 namespace Decrypt {
 
@@ -67,39 +71,14 @@ Message data(const uint8_t sym,
     return msg;
 }
 
-Message pka(const SecretKey & pri,
-            const std::string & passphrase,
-            const Message & message) {
-    if (!pri.meaningful()) {
-        // "Error: Bad private key.\n";
-        return Message();
-    }
-
-    if (!message.meaningful()) {
-        // "Error: No encrypted message found.\n";
-        return Message();
-    }
-
-    // find Public-Key Encrypted Session Key Packet (Tag 1)
-    // should be first packet
-    Packet::Tag1::Ptr tag1 = nullptr;
-    for(Packet::Tag::Ptr const & p : message.get_packets()) {
-        if (p -> get_tag() == Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) {
-            tag1 = std::static_pointer_cast <Packet::Tag1> (p);
-            break;
-        }
-    }
-
-    if (!tag1) {
-        // "Error: No " + Packet::NAME.at(Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) + " (Tag " + std::to_string(Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) + ") found.\n";
-        return Message();
-    }
-
-    if (!PKA::can_encrypt(tag1 -> get_pka())) {
-        // "Error: Public Key Algorithm detected cannot be used to encrypt/decrypt.\n";
-        return Message();
-    }
+namespace {
 
+// get the session key from a Public-Key Encrypted Session Key Packet
+bool pka_session_key(const SecretKey & pri,
+                     const std::string & passphrase,
+                     const Packet::Tag1::Ptr & tag1,
+                     uint8_t & sym,
+                     std::string & session_key) {
     // find corresponding secret key
     Packet::Tag5::Ptr sec = nullptr;
     for(Packet::Tag::Ptr const & p : pri.get_packets()) {
@@ -120,28 +99,48 @@ Message pka(const SecretKey & pri,
 
     if (!sec) {
         // "Error: Correct Private Key not found.\n";
-        return Message();
+        return false;
     }
 
     // decrypt secret keys
     std::string symkey;
-    if ((tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
-        (tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
-        symkey = mpitoraw(PKA::RSA::decrypt(tag1 -> get_mpi()[0], sec -> decrypt_secret_keys(passphrase), sec -> get_mpi()));
-    }
-    else if (tag1 -> get_pka() == PKA::ID::ELGAMAL) {
-        symkey = PKA::ElGamal::decrypt(tag1 -> get_mpi(), sec -> decrypt_secret_keys(passphrase), sec -> get_mpi());
+    #ifdef GPG_COMPATIBLE
+    if (tag1 -> get_pka() == PKA::ID::ECDH) {
+        // RFC 6637 sec 8: unwrap with the key derived from the ephemeral point
+        const Packet::Key::Ptr pub = sec -> get_public_ptr();
+        symkey = PKA::ECDH::decrypt(tag1 -> get_mpi(), tag1 -> get_wrapped(), sec -> decrypt_secret_keys(passphrase), pub -> get_kdf_hash(), pub -> get_kdf_alg(),
+                                    PKA::ECDH::param(pub -> get_curve(), pub -> get_kdf_hash(), pub -> get_kdf_alg(), pub -> get_fingerprint()));
+        if (!symkey.size()) {
+            // "Error: ECDH decryption failure.\n";
+            return false;
+        }
     }
+    else
+    #endif
+    {
+        if ((tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
+            (tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
+            symkey = mpitoraw(PKA::RSA::decrypt(tag1 -> get_mpi()[0], sec -> decrypt_secret_keys(passphrase), sec -> get_mpi()));
+        }
+        else if (tag1 -> get_pka() == PKA::ID::ELGAMAL) {
+            symkey = PKA::ElGamal::decrypt(tag1 -> get_mpi(), sec -> decrypt_secret_keys(passphrase), sec -> get_mpi());
+        }
 
-    // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
-    symkey = zero + symkey;
+        // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
+        symkey = zero + symkey;
 
-    if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()) {                  // remove EME_PKCS1 encoding
-        // "Error: EME_PKCS1v1_5_DECODE failure.\n";
-        return Message();
+        if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()) {              // remove EME_PKCS1 encoding
+            // "Error: EME_PKCS1v1_5_DECODE failure.\n";
+            return false;
+        }
+    }
+
+    if (symkey.size() < 3) {
+        // "Error: Session key too short.\n";
+        return false;
     }
 
-    const uint8_t sym = symkey[0];                                          // get symmetric algorithm
+    sym = symkey[0];                                                        // get symmetric algorithm
     const std::string checksum = symkey.substr(symkey.size() - 2, 2);       // get 2 octet checksum
     symkey = symkey.substr(1, symkey.size() - 3);                           // remove both from session key
 
@@ -152,6 +151,71 @@ Message pka(const SecretKey & pri,
 
     if (unhexlify(makehex(sum, 4)) != checksum) {                           // check session key checksums
         // "Error: Calculated session key checksum does not match given checksum.\n";
+        return false;
+    }
+
+    session_key = symkey;
+    return true;
+}
+
+// longest session key packet body accepted by Stream
+const std::size_t MAX_SESSION_KEY_PACKET = 65536;
+
+// "\xd3\x14" + SHA1
+const std::size_t MDC_PACKET_LENGTH = 22;
+
+// octets read from a std::istream at a time
+const std::size_t READ_SIZE = 65536;
+
+// thrown inside of Stream to stop with a Status
+struct Failure {
+    Status status;
+};
+
+void check(const Status status) {
+    if (status != Status::SUCCESS) {
+        throw Failure{status};
+    }
+}
+
+}
+
+Message pka(const SecretKey & pri,
+            const std::string & passphrase,
+            const Message & message) {
+    if (!pri.meaningful()) {
+        // "Error: Bad private key.\n";
+        return Message();
+    }
+
+    if (!message.meaningful()) {
+        // "Error: No encrypted message found.\n";
+        return Message();
+    }
+
+    // find Public-Key Encrypted Session Key Packet (Tag 1)
+    // should be first packet
+    Packet::Tag1::Ptr tag1 = nullptr;
+    for(Packet::Tag::Ptr const & p : message.get_packets()) {
+        if (p -> get_tag() == Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) {
+            tag1 = std::static_pointer_cast <Packet::Tag1> (p);
+            break;
+        }
+    }
+
+    if (!tag1) {
+        // "Error: No " + Packet::NAME.at(Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) + " (Tag " + std::to_string(Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) + ") found.\n";
+        return Message();
+    }
+
+    if (!PKA::can_encrypt(tag1 -> get_pka())) {
+        // "Error: Public Key Algorithm detected cannot be used to encrypt/decrypt.\n";
+        return Message();
+    }
+
+    uint8_t sym = 0;
+    std::string symkey;
+    if (!pka_session_key(pri, passphrase, tag1, sym, symkey)) {
         return Message();
     }
 
@@ -185,5 +249,275 @@ Message sym(const Message & message,
     return data(symkey[0], message, symkey.substr(1, symkey.size() - 1));
 }
 
+Stream::Stream(const SecretKey & pri,
+               const std::string & passphrase,
+               const Output & output,
+               const Compression::Budget & budget)
+    : pri(std::make_shared <SecretKey> (pri)),
+      passphrase(passphrase),
+      out(output),
+      budget(budget),
+      status(Status::SUCCESS),
+      reader([this](const uint8_t tag, const std::string & data, const bool last) { read_packet(tag, data, last); }),
+      packet(),
+      sym(0),
+      session_key(),
+      encrypted(0),
+      head(),
+      cfb(nullptr),
+      mdc(nullptr),
+      prefix(0),
+      tail(),
+      contents(nullptr),
+      done(false)
+{
+    if (!pri.meaningful()) {
+        // "Error: Bad private key.\n";
+        status = Status::INVALID;
+    }
+}
+
+Stream::Stream(const std::string & passphrase,
+               const Output & output,
+               const Compression::Budget & budget)
+    : pri(nullptr),
+      passphrase(passphrase),
+      out(output),
+      budget(budget),
+      status(Status::SUCCESS),
+      reader([this](const uint8_t tag, const std::string & data, const bool last) { read_packet(tag, data, last); }),
+      packet(),
+      sym(0),
+      session_key(),
+      encrypted(0),
+      head(),
+      cfb(nullptr),
+      mdc(nullptr),
+      prefix(0),
+      tail(),
+      contents(nullptr),
+      done(false)
+{}
+
+void Stream::read_packet(const uint8_t tag, const std::string & data, const bool last) {
+    // anything after the encrypted data is ignored
+    if (done) {
+        return;
+    }
+
+    switch (tag) {
+        case Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY:
+        case Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY:
+            packet += data;
+            if (packet.size() > MAX_SESSION_KEY_PACKET) {
+                throw Failure{Status::INVALID_LENGTH};
+            }
+
+            if (last) {
+                read_session_key(tag);
+                packet.clear();
+            }
+            break;
+        case Packet::SYMMETRICALLY_ENCRYPTED_DATA:
+        case Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:
+            if (!encrypted) {
+                if (!session_key.size()) {
+                    throw Failure{Status::MISSING_SESSION_KEY};
+                }
+
+                if (Sym::BLOCK_LENGTH.find(sym) == Sym::BLOCK_LENGTH.end()) {
+                    throw Failure{Status::INVALID_SYMMETRIC_ENCRYPTION_ALGORITHM};
+                }
+
+                encrypted = tag;
+            }
+
+            read_encrypted(data, last);
+            break;
+        default:                            // Marker Packets
+            break;
+    }
+}
+
+// use the first session key packet that can be decrypted
+void Stream::read_session_key(const uint8_t tag) {
+    if (session_key.size()) {
+        return;
+    }
+
+    try {
+        if (tag == Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY) {
+            if (!pri) {
+                return;
+            }
+
+            const Packet::Tag1::Ptr tag1 = std::make_shared <Packet::Tag1> (packet);
+            if (PKA::can_encrypt(tag1 -> get_pka()) &&
+                !pka_session_key(*pri, passphrase, tag1, sym, session_key)) {
+                session_key.clear();
+            }
+        }
+        else {
+            if (pri) {
+                return;
+            }
+
+            const std::string symkey = Packet::Tag3(packet).get_session_key(passphrase);
+            if (symkey.size() > 1) {
+                sym = symkey[0];
+                session_key = symkey.substr(1, symkey.size() - 1);
+            }
+        }
+    }
+    catch (const std::exception &) {
+        // try the next session key packet
+        session_key.clear();
+    }
+}
+
+void Stream::read_encrypted(const std::string & data, const bool last) {
+    std::string::size_type pos = 0;
+    if (!cfb) {
+        const std::size_t BS = Sym::BLOCK_LENGTH.at(sym) >> 3;
+
+        // Tag 18 starts with a version number and Tag 9 with the prefix,
+        // encrypted with resynchronization
+        const std::size_t need = (encrypted == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA)?1:(BS + 2);
+        pos = std::min(need - head.size(), data.size());
+        head.append(data, 0, pos);
+
+        if (head.size() < need) {
+            if (last) {
+                throw Failure{Status::INVALID_LENGTH};
+            }
+            return;
+        }
+
+        const SymAlg::Ptr crypt = Sym::setup(sym, session_key);
+        if (encrypted == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA) {
+            if (head[0] != 1) {
+                throw Failure{Status::INVALID_VERSION};
+            }
+
+            // the decrypted prefix is hashed but not used
+            cfb = std::make_shared <CFB> (crypt, true);
+            mdc = Hash::get_instance(Hash::ID::SHA1);
+            prefix = BS + 2;
+        }
+        else {
+            // after the prefix, OpenPGP CFB is standard CFB with C[3] to C[BS + 2] as the IV
+            cfb = std::make_shared <CFB> (crypt, true, head.substr(2, BS));
+        }
+
+        contents = std::make_shared <MessageReader> (out, nullptr, budget);
+    }
+
+    if (pos < data.size()) {
+        read_plaintext(cfb -> update(pos?data.substr(pos):data));
+    }
+
+    if (last) {
+        done = true;
+
+        if (mdc) {
+            // Modification Detection Code Packet (Tag 19)
+            if ((tail.size() != MDC_PACKET_LENGTH) || (tail.substr(0, 2) != "\xd3\x14")) {
+                throw Failure{Status::INVALID_SHA1_HASH};
+            }
+
+            mdc -> update(tail.substr(0, 2));
+            if (mdc -> digest() != tail.substr(2)) {
+                // "Error: Given checksum and calculated checksum do not match.";
+                throw Failure{Status::INVALID_SHA1_HASH};
+            }
+        }
+
+        check(contents -> finish());
+    }
+}
+
+void Stream::read_plaintext(const std::string & data) {
+    if (!mdc) {
+        check(contents -> update(data));
+        return;
+    }
+
+    // skip the prefix
+    std::string::size_type pos = 0;
+    if (prefix) {
+        pos = std::min(prefix, data.size());
+        mdc -> update(data.substr(0, pos));
+        prefix -= pos;
+    }
+
+    // hold back what might be the MDC packet
+    tail.append(data, pos, std::string::npos);
+    if (tail.size() > MDC_PACKET_LENGTH) {
+        const std::string plaintext = tail.substr(0, tail.size() - MDC_PACKET_LENGTH);
+        tail.erase(0, plaintext.size());
+        mdc -> update(plaintext);
+        check(contents -> update(plaintext));
+    }
+}
+
+Status Stream::update(const std::string & data) {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    try {
+        reader.update(data);
+    }
+    catch (const Failure & failure) {
+        status = failure.status;
+    }
+    catch (const std::exception &) {
+        // malformed packets can also throw std::logic_error
+        status = Status::INVALID;
+    }
+
+    return status;
+}
+
+Status Stream::finish() {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    try {
+        reader.finish();
+    }
+    catch (const std::exception &) {
+        status = Status::INVALID_LENGTH;
+        return status;
+    }
+
+    if (!done) {
+        if (encrypted) {
+            status = Status::INVALID_LENGTH;
+        }
+        else if (!session_key.size()) {
+            status = Status::MISSING_SESSION_KEY;
+        }
+        else {
+            // "Error: No encrypted data found.\n";
+            status = Status::INVALID;
+        }
+    }
+
+    return status;
+}
+
+Status Stream::read(std::istream & stream) {
+    std::string buffer(READ_SIZE, 0);
+    while (stream.read(&buffer[0], buffer.size()) || stream.gcount()) {
+        if (update(buffer.substr(0, stream.gcount())) != Status::SUCCESS) {
+            return status;
+        }
+    }
+
+    return finish();
+}
+
 }
 }
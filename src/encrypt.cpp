@@ -1,5 +1,7 @@
 #include "encrypt.h"
 
+#include <stdexcept>
+
 namespace OpenPGP {
 namespace Encrypt {
 
@@ -13,10 +15,16 @@ Packet::Tag::Ptr data(const Args & args,
 
     std::string to_encrypt;
 
+    // skip compression or pick a level based on the data
+    const Compression::Decision comp = Compression::decide(args.comp, args.data, args.level, args.strategy);
+    if (args.observer) {
+        args.observer(comp);
+    }
+
     // if message is to be signed
     if (args.signer) {
         const Sign::Args signargs(*(args.signer), args.passphrase, 4, args.hash);
-        Message signed_message = Sign::binary(signargs, args.filename, args.data, args.comp);
+        Message signed_message = Sign::binary(signargs, args.filename, args.data, comp.alg, comp.level, comp.strategy);
         if (!signed_message.meaningful()) {
             // "Error: Signing failure.\n";
             return nullptr;
@@ -35,11 +43,13 @@ Packet::Tag::Ptr data(const Args & args,
 
         to_encrypt = tag11.write();
 
-        if (args.comp) {
+        if (comp.alg) {
             // Compressed Data Packet (Tag 8)
             Packet::Tag8 tag8;
             tag8.set_header_format(Packet::HeaderFormat::NEW);
-            tag8.set_comp(args.comp);
+            tag8.set_comp(comp.alg);
+            tag8.set_level(comp.level);
+            tag8.set_strategy(comp.strategy);
             tag8.set_data(to_encrypt); // put source data into compressed packet
             to_encrypt = tag8.write();
         }
@@ -59,8 +69,13 @@ Packet::Tag::Ptr data(const Args & args,
     }
     else{
         // Modification Detection Code Packet (Tag 19)
+        Hash::Context <Hash::ID::SHA1> mdc;
+        mdc.update(prefix);
+        mdc.update(to_encrypt);
+        mdc.update("\xd3\x14");
+
         Packet::Tag19 tag19;
-        tag19.set_hash(Hash::use(Hash::ID::SHA1, prefix + to_encrypt + "\xd3\x14"));
+        tag19.set_hash(mdc.digest());
 
         // Sym. Encrypted Integrity Protected Data Packet (Tag 18)
         // encrypt(compressed(literal_data_packet(plain text)) + MDC SHA1(20 octets))
@@ -72,27 +87,24 @@ Packet::Tag::Ptr data(const Args & args,
     return encrypted;
 }
 
-Message pka(const Args & args,
-            const Key & pgpkey) {
-    if (!args.valid()) {
-        // "Error: Bad argument.\n";
-        return Message();
-    }
+namespace {
 
+// Public-Key Encrypted Session Key Packet for a new session key
+Packet::Tag1::Ptr pka_session_key(const uint8_t sym, const Key & pgpkey, std::string & session_key) {
     if (!pgpkey.meaningful()) {
         // "Error: Bad key.\n";
-        return Message();
+        return nullptr;
     }
 
     // Check if key has been revoked
     const int rc = Revoke::check(pgpkey);
     if (rc == true) {
         // "Error: Key " + hexlify(pgpkey.keyid()) + " has been revoked. Nothing done.\n";
-        return Message();
+        return nullptr;
     }
     else if (rc == -1) {
         // "Error: check_revoked failed.\n";
-        return Message();
+        return nullptr;
     }
 
     Packet::Key::Ptr key = nullptr;
@@ -110,7 +122,7 @@ Message pka(const Args & args,
 
     if (!key) {
         // "Error: No encrypting key found.\n";
-        return Message();
+        return nullptr;
     }
 
     PKA::Values mpi = key -> get_mpi();
@@ -121,7 +133,7 @@ Message pka(const Args & args,
     // do calculations
 
     // generate session key
-    const std::string session_key = RNG::RNG().rand_bytes(Sym::KEY_LENGTH.at(args.sym) >> 3);
+    session_key = RNG::RNG().rand_bytes(Sym::KEY_LENGTH.at(sym) >> 3);
 
     // get checksum of session key
     uint16_t sum = 0;
@@ -129,17 +141,83 @@ Message pka(const Args & args,
         sum += static_cast <unsigned char> (c);
     }
 
-    std::string nibbles = mpitohex(mpi[0]);        // get hex representation of modulus
-    nibbles += std::string(nibbles.size() & 1, 0); // get even number of nibbles
-    MPI m = rawtompi(EME_PKCS1v1_5_ENCODE(std::string(1, args.sym) + session_key + unhexlify(makehex(sum, 4)), nibbles.size() >> 1));
+    const std::string keydata = std::string(1, sym) + session_key + unhexlify(makehex(sum, 4));
 
-    // encrypt m
-    if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
-        (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
-        tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
+    #ifdef GPG_COMPATIBLE
+    if (key -> get_pka() == PKA::ID::ECDH) {
+        // RFC 6637 sec 8: keydata is wrapped with a key derived from
+        // an ephemeral X25519 exchange instead of PKCS#1 encoded
+        if (key -> get_curve() != unhexlify(PKA::CURVE_OID::CURVE_255)) {
+            // "Error: Only Curve25519 ECDH keys are supported.\n";
+            return nullptr;
+        }
+
+        std::string wrapped;
+        tag1 -> set_mpi(PKA::ECDH::encrypt(keydata, mpi, key -> get_kdf_hash(), key -> get_kdf_alg(),
+                                           PKA::ECDH::param(key -> get_curve(), key -> get_kdf_hash(), key -> get_kdf_alg(), key -> get_fingerprint()),
+                                           wrapped));
+        tag1 -> set_wrapped(wrapped);
     }
-    else if (key -> get_pka() == PKA::ID::ELGAMAL) {
-        tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi));
+    else
+    #endif
+    {
+        std::string nibbles = mpitohex(mpi[0]);        // get hex representation of modulus
+        nibbles += std::string(nibbles.size() & 1, 0); // get even number of nibbles
+        MPI m = rawtompi(EME_PKCS1v1_5_ENCODE(keydata, nibbles.size() >> 1));
+
+        // encrypt m
+        if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
+            (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)) {
+            tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
+        }
+        else if (key -> get_pka() == PKA::ID::ELGAMAL) {
+            tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi));
+        }
+    }
+
+    if (!tag1 -> get_mpi().size()) {
+        // "Error: Failed to encrypt session key.\n";
+        return nullptr;
+    }
+
+    return tag1;
+}
+
+// Symmetric-Key Encrypted Session Key Packet for a key derived from passphrase
+Packet::Tag3::Ptr sym_session_key(const uint8_t sym, const std::string & passphrase, const uint8_t key_hash, std::string & session_key) {
+    // String to Key specifier for decrypting session key
+    S2K::S2K3::Ptr s2k = std::make_shared <S2K::S2K3> ();
+    s2k -> set_type(S2K::ID::ITERATED_AND_SALTED_S2K);
+    s2k -> set_hash(key_hash);
+    s2k -> set_salt(RNG::RNG().rand_bytes(8));
+    s2k -> set_count(96);
+
+    // generate Symmetric-Key Encrypted Session Key Packets (Tag 3)
+    Packet::Tag3::Ptr tag3 = std::make_shared <Packet::Tag3> ();
+    tag3 -> set_version(4);
+    tag3 -> set_sym(sym);
+    tag3 -> set_s2k(s2k);
+
+    // generate session key
+    const std::string key = tag3 -> get_session_key(passphrase);
+    session_key = key.substr(1, key.size() - 1);
+
+    return tag3;
+}
+
+}
+
+Message pka(const Args & args,
+            const Key & pgpkey) {
+    if (!args.valid()) {
+        // "Error: Bad argument.\n";
+        return Message();
+    }
+
+    std::string session_key;
+    Packet::Tag1::Ptr tag1 = pka_session_key(args.sym, pgpkey, session_key);
+    if (!tag1) {
+        return Message();
     }
 
     // encrypt data and put it into a packet
@@ -165,24 +243,11 @@ Message sym(const Args & args,
         return Message();
     }
 
-    // String to Key specifier for decrypting session key
-    S2K::S2K3::Ptr s2k = std::make_shared <S2K::S2K3> ();
-    s2k -> set_type(S2K::ID::ITERATED_AND_SALTED_S2K);
-    s2k -> set_hash(key_hash);
-    s2k -> set_salt(RNG::RNG().rand_bytes(8));
-    s2k -> set_count(96);
-
-    // generate Symmetric-Key Encrypted Session Key Packets (Tag 3)
-    Packet::Tag3::Ptr tag3 = std::make_shared <Packet::Tag3> ();
-    tag3 -> set_version(4);
-    tag3 -> set_sym(args.sym);
-    tag3 -> set_s2k(s2k);
-
-    // generate session key
-    const std::string session_key = tag3 -> get_session_key(passphrase);
+    std::string session_key;
+    Packet::Tag3::Ptr tag3 = sym_session_key(args.sym, passphrase, key_hash, session_key);
 
     // encrypt data
-    Packet::Tag::Ptr encrypted = data(args, session_key.substr(1, session_key.size() - 1));
+    Packet::Tag::Ptr encrypted = data(args, session_key);
     if (!encrypted) {
         // "Error: Failed to encrypt data.\n";
         return Message();
@@ -196,5 +261,192 @@ Message sym(const Args & args,
     return out;
 }
 
+Stream::Stream(const Args & args, const Key & pub, const Output & output)
+    : args(args),
+      out(output),
+      cfb(nullptr),
+      mdc(nullptr),
+      compressor(nullptr),
+      encrypted(nullptr),
+      compressed(nullptr),
+      literal(nullptr),
+      signing(nullptr),
+      pending(),
+      finished(false)
+{
+    if (!args.valid()) {
+        throw std::runtime_error("Error: Bad argument.");
+    }
+
+    if (args.signer && !find_signing_key(*(args.signer))) {
+        throw std::runtime_error("Error: No signing key found.");
+    }
+
+    std::string session_key;
+    Packet::Tag1::Ptr tag1 = pka_session_key(args.sym, pub, session_key);
+    if (!tag1) {
+        throw std::runtime_error("Error: Failed to encrypt session key.");
+    }
+
+    out(tag1 -> write());
+    start(session_key);
+}
+
+Stream::Stream(const Args & args, const std::string & passphrase, const uint8_t key_hash, const Output & output)
+    : args(args),
+      out(output),
+      cfb(nullptr),
+      mdc(nullptr),
+      compressor(nullptr),
+      encrypted(nullptr),
+      compressed(nullptr),
+      literal(nullptr),
+      signing(nullptr),
+      pending(),
+      finished(false)
+{
+    if (!args.valid()) {
+        throw std::runtime_error("Error: Bad argument.");
+    }
+
+    if (args.signer && !find_signing_key(*(args.signer))) {
+        throw std::runtime_error("Error: No signing key found.");
+    }
+
+    std::string session_key;
+    Packet::Tag3::Ptr tag3 = sym_session_key(args.sym, passphrase, key_hash, session_key);
+
+    out(tag3 -> write());
+    start(session_key);
+}
+
+// write the encrypted packet header and the encrypted prefix
+void Stream::start(const std::string & session_key) {
+    const SymAlg::Ptr crypt = Sym::setup(args.sym, session_key);
+    const std::size_t BS = crypt -> blocksize() >> 3;
+
+    // generate prefix
+    std::string prefix = RNG::RNG().rand_bytes(BS);
+    prefix += prefix.substr(BS - 2, 2);
+
+    if (!args.mdc) {
+        // Symmetrically Encrypted Data Packet (Tag 9)
+        // the prefix is encrypted with resynchronization, after which
+        // OpenPGP CFB is standard CFB with C[3] to C[BS + 2] as the IV
+        encrypted = std::make_shared <Packet::PartialWriter> (out, Packet::SYMMETRICALLY_ENCRYPTED_DATA);
+        const std::string C = OpenPGP_CFB_encrypt(crypt, Packet::SYMMETRICALLY_ENCRYPTED_DATA, "", prefix);
+        encrypted -> write(C);
+        cfb = std::make_shared <CFB> (crypt, false, C.substr(2, BS));
+    }
+    else{
+        // Sym. Encrypted Integrity Protected Data Packet (Tag 18)
+        encrypted = std::make_shared <Packet::PartialWriter> (out, Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA);
+        encrypted -> write(std::string(1, 1));     // version
+        mdc = Hash::get_instance(Hash::ID::SHA1, prefix);
+        cfb = std::make_shared <CFB> (crypt, false);
+        encrypted -> write(cfb -> update(prefix));
+    }
+}
+
+// pick the compression from the held data, then write it
+void Stream::start_literal() {
+    // skip compression or pick a level based on the data
+    const Compression::Decision comp = Compression::decide(args.comp, pending, args.level, args.strategy);
+    if (args.observer) {
+        args.observer(comp);
+    }
+
+    Output literal_out = [this](const std::string & data) { write_plaintext(data); };
+
+    // if message is to be signed
+    if (args.signer) {
+        const Sign::Args signargs(*(args.signer), args.passphrase, 4, args.hash);
+        signing = std::make_shared <Sign::Stream> (signargs, args.filename, literal_out, comp.alg, comp.level, comp.strategy);
+        signing -> update(pending);
+        std::string().swap(pending);
+        return;
+    }
+
+    if (comp.alg) {
+        // Compressed Data Packet (Tag 8)
+        compressor = Compression::compressor(comp.alg, comp.level, comp.strategy);
+        compressed = std::make_shared <Packet::PartialWriter> (literal_out, Packet::COMPRESSED_DATA);
+        compressed -> write(std::string(1, comp.alg));
+        literal_out = [this](const std::string & data) { compressed -> write(compressor -> update(data)); };
+    }
+
+    // Literal Data Packet (Tag 11) without its literal data
+    Packet::Tag11 tag11;
+    tag11.set_data_format('b');
+    tag11.set_filename(args.filename);
+    tag11.set_time(0);
+
+    literal = std::make_shared <Packet::PartialWriter> (literal_out, Packet::LITERAL_DATA);
+    literal -> write(tag11.raw());
+    literal -> write(pending);
+    std::string().swap(pending);
+}
+
+void Stream::write_plaintext(const std::string & data) {
+    if (mdc) {
+        mdc -> update(data);
+    }
+    encrypted -> write(cfb -> update(data));
+}
+
+void Stream::update(const std::string & data) {
+    if (finished) {
+        throw std::runtime_error("Error: Stream was already finished.");
+    }
+
+    if (signing) {
+        signing -> update(data);
+        return;
+    }
+
+    if (literal) {
+        literal -> write(data);
+        return;
+    }
+
+    pending += data;
+    if (pending.size() >= Compression::POLICY_SAMPLE) {
+        start_literal();
+    }
+}
+
+void Stream::finish() {
+    if (finished) {
+        return;
+    }
+
+    if (!literal && !signing) {
+        start_literal();
+    }
+
+    if (signing) {
+        signing -> finish();
+    }
+    else {
+        literal -> finish();
+
+        if (compressed) {
+            compressed -> write(compressor -> finish());
+            compressed -> finish();
+        }
+    }
+
+    if (mdc) {
+        // Modification Detection Code Packet (Tag 19)
+        // the hash covers the prefix, the data, and the MDC packet header
+        const std::string header = "\xd3\x14";
+        mdc -> update(header);
+        encrypted -> write(cfb -> update(header + mdc -> digest()));
+    }
+
+    encrypted -> finish();
+    finished = true;
+}
+
 }
 }
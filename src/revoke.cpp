@@ -78,7 +78,7 @@ Packet::Tag2::Ptr sig(const Packet::Tag5::Ptr & signer, const std::string & pass
     }
 
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = Sign::with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(passphrase), signer -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = Sign::with_pka(digest, signer, passphrase, sig -> get_hash());
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -184,7 +184,7 @@ Packet::Tag2::Ptr uid_sig(const Packet::Tag5::Ptr & signer, const std::string &
     // set signature data
     std::string digest = to_sign_30(signer, user, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = Sign::with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(passphrase), signer -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = Sign::with_pka(digest, signer, passphrase, sig -> get_hash());
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return nullptr;
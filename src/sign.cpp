@@ -5,7 +5,7 @@
 namespace OpenPGP {
 namespace Sign {
 
-PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash) {
+PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash, const std::string & curve) {
     if ((pka == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
         (pka == PKA::ID::RSA_ENCRYPT_ONLY)) {
         // RFC 4880 sec 5.2.2
@@ -15,11 +15,32 @@ PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::V
     else if (pka == PKA::ID::DSA) {
         return PKA::DSA::sign(digest, pri, pub);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::EdDSA) {
+        if (!PKA::EdDSA::supported(curve)) {
+            // "Error: Unsupported EdDSA curve.\n";
+            return {};
+        }
+        return PKA::EdDSA::sign(digest, pri, pub);
+    }
+    else if (pka == PKA::ID::ECDSA) {
+        return PKA::ECDSA::sign(digest, pri, pub, curve);
+    }
+    #endif
 
     // "Error: Undefined or incorrect PKA number: " + std::to_string(pka) + "\n";
     return {};
 }
 
+PKA::Values with_pka(const std::string & digest, const Packet::Tag5::Ptr & signer, const std::string & passphrase, const uint8_t hash) {
+    #ifdef GPG_COMPATIBLE
+    const std::string curve = signer -> get_curve();
+    #else
+    const std::string curve = "";
+    #endif
+    return with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(passphrase), signer -> get_mpi(), hash, curve);
+}
+
 Packet::Tag2::Ptr create_sig_packet(const uint8_t version, const uint8_t type, const uint8_t pka, const uint8_t hash, const std::string & keyid) {
     // Set up signature packet
     Packet::Tag2::Ptr tag2 = std::make_shared <Packet::Tag2> ();
@@ -68,7 +89,7 @@ DetachedSignature detached_signature(const Args & args, const std::string & data
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_BINARY_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
     const std::string digest = to_sign_00(binary_to_canonical(data), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return DetachedSignature();
@@ -83,7 +104,7 @@ DetachedSignature detached_signature(const Args & args, const std::string & data
 }
 
 // 0x00: Signature of a binary document.
-Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress) {
+Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress, const int level, const int strategy) {
     if (!args.valid()) {
         // "Error: Bad argument.\n";
         return DetachedSignature();
@@ -115,7 +136,7 @@ Message binary(const Args & args, const std::string & filename, const std::strin
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_BINARY_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
     const std::string digest = to_sign_00(binary_to_canonical(tag11 -> get_literal()), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return Message();
@@ -132,6 +153,8 @@ Message binary(const Args & args, const std::string & filename, const std::strin
         tag8.set_header_format(Packet::HeaderFormat::NEW);
         tag8.set_data(signature.raw());
         tag8.set_comp(compress);
+        tag8.set_level(level);
+        tag8.set_strategy(strategy);
         std::string raw = tag8.write();
         signature = Message(raw);
     }
@@ -139,6 +162,101 @@ Message binary(const Args & args, const std::string & filename, const std::strin
     return signature;
 }
 
+Stream::Stream(const Args & args,
+               const std::string & filename,
+               const Output & output,
+               const uint8_t compress,
+               const int level,
+               const int strategy)
+    : signer(nullptr),
+      passphrase(args.passphrase),
+      sig(nullptr),
+      hash(nullptr),
+      out(output),
+      compressor(nullptr),
+      compressed(nullptr),
+      literal(nullptr),
+      finished(false)
+{
+    if (!args.valid()) {
+        throw std::runtime_error("Error: Bad argument.");
+    }
+
+    // find signing key
+    signer = std::static_pointer_cast <Packet::Tag5> (find_signing_key(args.pri));
+    if (!signer) {
+        throw std::runtime_error("Error: No signing key found.");
+    }
+
+    if (compress) {
+        if (!Compression::valid(compress) || (compress > Compression::ID::BZIP2)) {
+            throw std::runtime_error("Error: Bad compression algorithm: " + std::to_string(compress));
+        }
+
+        // Compressed Data Packet (Tag 8) around everything else
+        compressor = Compression::compressor(compress, level, strategy);
+        compressed = std::make_shared <Packet::PartialWriter> (output, Packet::COMPRESSED_DATA);
+        compressed -> write(std::string(1, compress));
+        out = [this](const std::string & data) { compressed -> write(compressor -> update(data)); };
+    }
+
+    // create One-Pass Signature Packet
+    Packet::Tag4 tag4;
+    tag4.set_type(0);
+    tag4.set_hash(args.hash);
+    tag4.set_pka(signer -> get_pka());
+    tag4.set_keyid(signer -> get_keyid());
+    tag4.set_last(1); // 1 for no nesting
+    out(tag4.write());
+
+    // Literal Data Packet without its literal data
+    Packet::Tag11 tag11;
+    tag11.set_data_format('b');
+    tag11.set_filename(filename);
+    tag11.set_time(now());
+
+    literal = std::make_shared <Packet::PartialWriter> (out, Packet::LITERAL_DATA);
+    literal -> write(tag11.raw());
+
+    sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_BINARY_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
+    hash = Hash::get_instance(args.hash);
+}
+
+void Stream::update(const std::string & data) {
+    if (finished) {
+        throw std::runtime_error("Error: Stream was already finished.");
+    }
+
+    hash -> update(binary_to_canonical(data));
+    literal -> write(data);
+}
+
+void Stream::finish() {
+    if (finished) {
+        return;
+    }
+
+    literal -> finish();
+
+    // sign data
+    hash -> update(gettrailer(sig));
+    const std::string digest = hash -> digest();
+    sig -> set_left16(digest.substr(0, 2));
+    PKA::Values vals = with_pka(digest, signer, passphrase, sig -> get_hash());
+    if (!vals.size()) {
+        throw std::runtime_error("Error: PKA Signing failed.");
+    }
+    sig -> set_mpi(vals);
+    out(sig -> write());
+
+    if (compressed) {
+        compressed -> write(compressor -> finish());
+        compressed -> finish();
+    }
+
+    finished = true;
+}
+
 // 0x01: Signature of a canonical text document.
 CleartextSignature cleartext_signature(const Args & args, const std::string & text) {
     if (!args.valid()) {
@@ -157,7 +275,7 @@ CleartextSignature cleartext_signature(const Args & args, const std::string & te
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_CANONICAL_TEXT_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
     const std::string digest = to_sign_01(CleartextSignature::data_to_text(text), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return CleartextSignature();
@@ -217,7 +335,7 @@ Packet::Tag2::Ptr primary_key(const Packet::Tag5::Ptr signer_signing_key, const
 
     const std::string digest = to_sign_cert(sig -> get_type(), signee_primary_key, signee_id, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer_signing_key -> get_pka(), signer_signing_key -> decrypt_secret_keys(passphrase), signer_signing_key -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = with_pka(digest, signer_signing_key, passphrase, sig -> get_hash());
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -360,7 +478,7 @@ Packet::Tag2::Ptr subkey_binding(const Packet::Tag5::Ptr & primary, const std::s
 
     const std::string digest = to_sign_18(primary, sub, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, primary -> get_pka(), primary -> decrypt_secret_keys(passphrase), primary -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = with_pka(digest, primary, passphrase, sig -> get_hash());
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -422,7 +540,7 @@ Packet::Tag2::Ptr primary_key_binding(const Args & args, const PublicKey & signe
 
     const std::string digest = to_sign_18(signee_primary, signer_subkey, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer_subkey -> get_pka(), signer_subkey -> decrypt_secret_keys(args.passphrase), signer_subkey -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer_subkey, args.passphrase, args.hash);
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -456,7 +574,7 @@ DetachedSignature timestamp(const Args & args, const uint32_t time) {
 
     const std::string digest = to_sign_40(sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()) {
         // "Error: PKA Signing failed.\n";
         return DetachedSignature();
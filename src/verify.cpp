@@ -1,9 +1,15 @@
 #include "verify.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
 namespace OpenPGP {
 namespace Verify {
 
-int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee) {
+int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee, const std::string & curve) {
     if ((pka == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
         (pka == PKA::ID::RSA_SIGN_ONLY)) {
         // RFC 4880 sec 5.2.2
@@ -13,16 +19,141 @@ int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka,
     else if (pka == PKA::ID::DSA) {
         return PKA::DSA::verify(digest, signee, signer);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::EdDSA) {
+        if (!PKA::EdDSA::supported(curve)) {
+            // "Error: Unsupported EdDSA curve.\n";
+            return -1;
+        }
+        return PKA::EdDSA::verify(digest, signee, signer);
+    }
+    else if (pka == PKA::ID::ECDSA) {
+        if (!PKA::ECDSA::supported(curve)) {
+            // "Error: Unsupported ECDSA curve.\n";
+            return -1;
+        }
+        return PKA::ECDSA::verify(digest, signee, signer, curve);
+    }
+    #endif
 
     // "Error: Bad PKA value.\n";
     return -1;
 }
 
 int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee) {
-    return with_pka(digest, signee -> get_hash(), signee -> get_pka(), signer -> get_mpi(), signee -> get_mpi());
+    #ifdef GPG_COMPATIBLE
+    const std::string curve = signer -> get_curve();
+    #else
+    const std::string curve = "";
+    #endif
+    return with_pka(digest, signee -> get_hash(), signee -> get_pka(), signer -> get_mpi(), signee -> get_mpi(), curve);
 }
 
-int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig) {
+Job::Job()
+    : signer(nullptr),
+      signature(nullptr),
+      digest(nullptr)
+{}
+
+Job::Job(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signature, const std::function <std::string ()> & digest)
+    : signer(signer),
+      signature(signature),
+      digest(digest)
+{}
+
+Job::Job(const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signature, const std::string & digest)
+    : Job(signer, signature, [digest]() { return digest; })
+{}
+
+Job::Job(const Packet::Key::Ptr & signer, const Packet::Key::Ptr & signee_key, const Packet::User::Ptr & signee_id, const Packet::Tag2::Ptr & signature)
+    : Job(signer, signature, [signee_key, signee_id, signature]() { return to_sign_cert(signature -> get_type(), signee_key, signee_id, signature); })
+{}
+
+namespace {
+
+int run(const Job & job) {
+    if (!job.signer || !job.signature || !job.digest) {
+        // "Error: Incomplete verification job.\n";
+        return -1;
+    }
+
+    // if the signing key's ID doesn't match with the signature's ID
+    if (job.signer -> get_keyid() != job.signature -> get_keyid()) {
+        return false;
+    }
+
+    const std::string digest = job.digest();
+
+    // cheap rejection before the PKA work
+    if (digest.substr(0, 2) != job.signature -> get_left16()) {
+        return false;
+    }
+
+    return with_pka(digest, job.signer, job.signature);
+}
+
+}
+
+std::vector <int> batch(const std::vector <Job> & jobs, ThreadPool & pool) {
+    std::vector <int> status(jobs.size(), -1);
+    if (jobs.empty()) {
+        return status;
+    }
+
+    // waiting on the pool from one of its own threads could deadlock
+    if (pool.in_worker()) {
+        for(std::size_t i = 0; i < jobs.size(); i++) {
+            try {
+                status[i] = run(jobs[i]);
+            }
+            catch (...) {
+                status[i] = -1;
+            }
+        }
+
+        return status;
+    }
+
+    // each task keeps claiming the next unverified job
+    std::atomic <std::size_t> next(0);
+    std::size_t remaining = std::min(pool.size(), jobs.size());
+    std::mutex mutex;
+    std::condition_variable done;
+
+    const std::size_t tasks = remaining;
+    for(std::size_t t = 0; t < tasks; t++) {
+        pool.submit([&]() {
+            for(std::size_t i = next++; i < jobs.size(); i = next++) {
+                try {
+                    status[i] = run(jobs[i]);
+                }
+                catch (...) {
+                    status[i] = -1;
+                }
+            }
+
+            std::lock_guard <std::mutex> lock(mutex);
+            if (!--remaining) {
+                done.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock <std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return !remaining; });
+
+    return status;
+}
+
+std::vector <int> batch(const std::vector <Job> & jobs, const std::size_t threads) {
+    ThreadPool pool(threads);
+    return batch(jobs, pool);
+}
+
+namespace {
+
+// hash_data puts the signed data into the hash context
+int detached_signature(const Key & key, const DetachedSignature & sig, const std::function <void (const Hash::Instance &)> & hash_data) {
     if (!key.meaningful()) {
         // "Error: Bad PGP Key.\n";
         return -1;
@@ -49,7 +180,17 @@ int detached_signature(const Key & key, const std::string & data, const Detached
 
     // calculate the digest of the data (treated as binary)
     // and check the left 16 bits
-    const std::string digest = to_sign_00(binary_to_canonical(data), signature);
+    const Hash::Instance hash = Hash::get_instance(signature -> get_hash());
+    try {
+        hash_data(hash);
+    }
+    catch (const std::runtime_error &) {
+        // "Error: Could not read signed data.\n";
+        return -1;
+    }
+    hash -> update(gettrailer(signature));
+
+    const std::string digest = hash -> digest();
     if (digest.substr(0, 2) != signature -> get_left16()) {
         // "Hash digest and given left 16 bits of hash do not match.\n";
         return false;
@@ -65,6 +206,26 @@ int detached_signature(const Key & key, const std::string & data, const Detached
     return with_pka(digest, signing_key, signature);
 }
 
+}
+
+int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig) {
+    return detached_signature(key, sig, [&data](const Hash::Instance & hash) {
+        hash -> update(binary_to_canonical(data));
+    });
+}
+
+int detached_signature(const Key & key, const int fd, const DetachedSignature & sig) {
+    return detached_signature(key, sig, [fd](const Hash::Instance & hash) {
+        from_fd(fd, [&hash](const char * data, const std::size_t len) { hash -> update(data, len); });
+    });
+}
+
+int detached_signature_file(const Key & key, const std::string & filename, const DetachedSignature & sig) {
+    return detached_signature(key, sig, [&filename](const Hash::Instance & hash) {
+        from_file(filename, [&hash](const char * data, const std::size_t len) { hash -> update(data, len); });
+    });
+}
+
 // 0x00: Signature of a binary document.
 int binary(const Key & key, const Message & message) {
     if (!key.meaningful()) {
@@ -204,6 +365,202 @@ int binary(const Key & key, const Message & message) {
     return -1;
 }
 
+namespace {
+
+// longest One-Pass Signature or Signature Packet body accepted by Stream
+const std::size_t MAX_SIGNATURE_PACKET = 65536;
+
+// octets read from a std::istream at a time
+const std::size_t READ_SIZE = 65536;
+
+}
+
+Stream::Stream(const Key & key,
+               const Output & output,
+               const Compression::Budget & budget)
+    : signing_key(find_signing_key(key)),
+      out(output),
+      status(Status::SUCCESS),
+      packet(),
+      one_pass(),
+      leading(),
+      closing(false),
+      finished(false),
+      results(),
+      reader([this](const std::string & data) { read_literal(data); },
+             [this](const uint8_t tag, const std::string & data, const bool last) { read_packet(tag, data, last); },
+             budget)
+{
+    if (!signing_key) {
+        throw std::runtime_error("Error: No public signing keys found.");
+    }
+}
+
+void Stream::read_packet(const uint8_t tag, const std::string & data, const bool last) {
+    if ((tag != Packet::ONE_PASS_SIGNATURE) && (tag != Packet::SIGNATURE)) {
+        return;
+    }
+
+    if ((packet.size() + data.size()) > MAX_SIGNATURE_PACKET) {
+        throw std::runtime_error("Error: Signature packet is too long.");
+    }
+
+    packet += data;
+    if (!last) {
+        return;
+    }
+
+    const std::string body = packet;
+    packet.clear();
+
+    if (tag == Packet::ONE_PASS_SIGNATURE) {
+        if (closing) {
+            throw std::runtime_error("Error: One-Pass Signature Packet found after the message.");
+        }
+
+        if (body.size() != 13) {
+            throw std::runtime_error("Error: One-Pass Signature Packet must be 13 octets.");
+        }
+
+        const Packet::Tag4 tag4(body);
+        one_pass.push_back(Pending{nullptr, tag4.get_hash(), Hash::get_instance(tag4.get_hash())});
+        return;
+    }
+
+    const Packet::Tag2::Ptr sig = std::make_shared <Packet::Tag2> (body);
+
+    // Signature Packet, OpenPGP Message
+    if (one_pass.empty()) {
+        if (closing) {
+            throw std::runtime_error("Error: Signature Packet does not match a One-Pass Signature Packet.");
+        }
+
+        leading.push_back(Pending{sig, sig -> get_hash(), Hash::get_instance(sig -> get_hash())});
+        return;
+    }
+
+    // the first Signature Packet after the message closes the last One-Pass Signature Packet
+    Pending pending = one_pass.back();
+    one_pass.pop_back();
+    closing = true;
+
+    pending.signature = sig;
+    results.push_back(Result{sig, check(pending)});
+}
+
+void Stream::read_literal(const std::string & data) {
+    if (closing) {
+        throw std::runtime_error("Error: Literal data found after the message.");
+    }
+
+    for(Pending & pending : one_pass) {
+        pending.instance -> update(binary_to_canonical(data));
+    }
+
+    for(Pending & pending : leading) {
+        pending.instance -> update(binary_to_canonical(data));
+    }
+
+    if (out) {
+        out(data);
+    }
+}
+
+int Stream::check(const Pending & pending) const {
+    if (pending.hash != pending.signature -> get_hash()) {
+        // "Error: One-Pass Signature Packet and Signature Packet hash algorithms do not match.\n";
+        return -1;
+    }
+
+    pending.instance -> update(gettrailer(pending.signature));
+    const std::string digest = pending.instance -> digest();
+    if (digest.substr(0, 2) != pending.signature -> get_left16()) {
+        // "Hash digest and given left 16 bits of hash do not match.\n";
+        return -1;
+    }
+
+    if (pending.signature -> get_keyid() != signing_key -> get_keyid()) {
+        return false;
+    }
+
+    return with_pka(digest, signing_key, pending.signature);
+}
+
+Status Stream::update(const std::string & data) {
+    if (status != Status::SUCCESS) {
+        return status;
+    }
+
+    if (finished) {
+        // "Error: Stream was already finished.\n";
+        return status = Status::INVALID;
+    }
+
+    return status = reader.update(data);
+}
+
+Status Stream::finish() {
+    if ((status != Status::SUCCESS) || finished) {
+        return status;
+    }
+
+    finished = true;
+
+    if ((status = reader.finish()) != Status::SUCCESS) {
+        return status;
+    }
+
+    if (!one_pass.empty() || packet.size()) {
+        // "Error: One-Pass Signature Packet without a Signature Packet.\n";
+        return status = Status::INVALID;
+    }
+
+    try {
+        for(Pending const & pending : leading) {
+            results.push_back(Result{pending.signature, check(pending)});
+        }
+    }
+    catch (const std::exception &) {
+        status = Status::INVALID;
+    }
+
+    return status;
+}
+
+Status Stream::read(std::istream & stream) {
+    std::string buffer(READ_SIZE, 0);
+    while (stream.read(&buffer[0], buffer.size()) || stream.gcount()) {
+        if (update(buffer.substr(0, stream.gcount())) != Status::SUCCESS) {
+            return status;
+        }
+    }
+
+    return finish();
+}
+
+const std::vector <Stream::Result> & Stream::get_results() const {
+    return results;
+}
+
+int Stream::verified() const {
+    if (!finished || (status != Status::SUCCESS) || results.empty()) {
+        return -1;
+    }
+
+    int rc = false;
+    for(Result const & result : results) {
+        if (result.status == true) {
+            return true;
+        }
+
+        if (result.status == -1) {
+            rc = -1;
+        }
+    }
+
+    return rc;
+}
+
 // Signature type 0x01
 int cleartext_signature(const Key & key, const CleartextSignature & message) {
     if (!key.meaningful()) {
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include "Compress/Compress.h"
+#include "Compress/Policy.h"
+#include "RNG/RNGs.h"
 
 #include "../testvectors/msg.h"
 
@@ -21,3 +23,167 @@ TEST(Compress, bzip2) {
     auto decompressed = OpenPGP::Compression::decompress(OpenPGP::Compression::ID::BZIP2, compressed);
     EXPECT_EQ(decompressed, MESSAGE);
 }
+
+TEST(Compress, stream) {
+    for(uint8_t const alg : {OpenPGP::Compression::ID::ZIP, OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}) {
+        std::string data;
+        for(int i = 0; i < 64; i++) {
+            data += MESSAGE + std::to_string(i);
+        }
+
+        // feed a few octets at a time
+        OpenPGP::Compression::Compressor::Ptr c = OpenPGP::Compression::compressor(alg);
+        std::string compressed;
+        for(std::string::size_type i = 0; i < data.size(); i += 1000) {
+            compressed += c -> update(data.substr(i, 1000));
+        }
+        compressed += c -> finish();
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, compressed), data);
+
+        OpenPGP::Compression::Decompressor::Ptr d = OpenPGP::Compression::decompressor(alg);
+        std::string decompressed;
+        for(std::string::size_type i = 0; i < compressed.size(); i += 7) {
+            decompressed += d -> update(compressed.substr(i, 7));
+        }
+        EXPECT_EQ(d -> done(), true);
+        decompressed += d -> finish();
+        EXPECT_EQ(decompressed, data);
+
+        // truncated stream
+        d = OpenPGP::Compression::decompressor(alg);
+        d -> update(compressed.substr(0, compressed.size() / 2));
+        EXPECT_EQ(d -> done(), false);
+        EXPECT_THROW(d -> finish(), std::runtime_error);
+        EXPECT_THROW(OpenPGP::Compression::decompress(alg, compressed.substr(0, compressed.size() / 2)), std::runtime_error);
+    }
+}
+
+TEST(Compress, parallel) {
+    std::string data;
+    for(int i = 0; i < 4096; i++) {
+        data += MESSAGE + std::to_string(i * i);
+    }
+
+    for(int const windowBits : {DEFLATE_WINDOWBITS, ZLIB_WINDOWBITS}) {
+        // small blocks so the input is split several times
+        std::string compressed;
+        ASSERT_EQ(zlib_compress_parallel(data, compressed, windowBits, Z_DEFAULT_COMPRESSION, Z_DEFAULT_STRATEGY, 4, 10000), Z_OK);
+
+        // standard inflater, which also checks the Adler-32 trailer
+        std::string decompressed;
+        ASSERT_EQ(zlib_decompress(compressed, decompressed, windowBits), Z_OK);
+        EXPECT_EQ(decompressed, data);
+
+        // the dictionary keeps the ratio close to a single stream
+        std::string serial;
+        ASSERT_EQ(zlib_compress(data, serial, windowBits), Z_OK);
+        EXPECT_LT(compressed.size(), serial.size() * 11 / 10);
+    }
+}
+
+TEST(Compress, bzip2_parallel) {
+    std::string data;
+    for(int i = 0; i < 4096; i++) {
+        data += MESSAGE + std::to_string(i * i);
+    }
+
+    // 100k blocks so the input spans several of them
+    std::string compressed;
+    ASSERT_EQ(bz2_compress_parallel(data, compressed, 1, 4), BZ_OK);
+
+    // standard decoder, which also checks the combined CRC
+    std::string decompressed;
+    ASSERT_EQ(bz2_decompress(compressed, decompressed), BZ_OK);
+    EXPECT_EQ(decompressed, data);
+
+    decompressed.clear();
+    ASSERT_EQ(bz2_decompress_parallel(compressed, decompressed, 4), BZ_OK);
+    EXPECT_EQ(decompressed, data);
+
+    // multi-block stream from a single compressor
+    std::string serial;
+    {
+        OpenPGP::Compression::Bz2Compressor compressor(1);
+        serial = compressor.update(data);
+        serial += compressor.finish();
+    }
+    decompressed.clear();
+    ASSERT_EQ(bz2_decompress_parallel(serial, decompressed, 4), BZ_OK);
+    EXPECT_EQ(decompressed, data);
+
+    EXPECT_NE(bz2_decompress_parallel(compressed.substr(0, compressed.size() - 8), decompressed, 4), BZ_OK);
+}
+
+TEST(Compress, policy) {
+    std::string text;
+    for(int i = 0; i < 256; i++) {
+        text += MESSAGE;
+    }
+
+    const OpenPGP::Compression::Decision compressible = OpenPGP::Compression::decide(OpenPGP::Compression::ID::ZLIB, text);
+    EXPECT_EQ(compressible.alg, OpenPGP::Compression::ID::ZLIB);
+    EXPECT_EQ(compressible.level, Z_DEFAULT_COMPRESSION);
+    EXPECT_LT(compressible.ratio, OpenPGP::Compression::POLICY_FAST_RATIO);
+
+    // already compressed data is left alone
+    const std::string compressed = OpenPGP::Compression::compress(OpenPGP::Compression::ID::BZIP2, text + OpenPGP::RNG::RNG().rand_bytes(100000));
+    const OpenPGP::Compression::Decision incompressible = OpenPGP::Compression::decide(OpenPGP::Compression::ID::ZLIB, compressed);
+    EXPECT_EQ(incompressible.alg, OpenPGP::Compression::ID::UNCOMPRESSED);
+
+    // 7 random bits per octet compresses a little, so the fastest level is used
+    std::string noisy = OpenPGP::RNG::RNG().rand_bytes(OpenPGP::Compression::POLICY_SAMPLE);
+    for(char & c : noisy) {
+        c &= 0x7f;
+    }
+    for(uint8_t const alg : {OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}) {
+        const OpenPGP::Compression::Decision poor = OpenPGP::Compression::decide(alg, noisy);
+        EXPECT_EQ(poor.alg, alg);
+        EXPECT_GT(poor.ratio, OpenPGP::Compression::POLICY_FAST_RATIO);
+        EXPECT_EQ(poor.level, 1);
+    }
+
+    // explicit settings are not second guessed
+    const OpenPGP::Compression::Decision forced = OpenPGP::Compression::decide(OpenPGP::Compression::ID::ZIP, compressed, 9, Z_FILTERED);
+    EXPECT_EQ(forced.alg, OpenPGP::Compression::ID::ZIP);
+    EXPECT_EQ(forced.level, 9);
+    EXPECT_EQ(forced.strategy, Z_FILTERED);
+    EXPECT_EQ(forced.sampled, 0);
+
+    EXPECT_EQ(OpenPGP::Compression::decompress(OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::compress(OpenPGP::Compression::ID::ZLIB, text, 1, Z_RLE)), text);
+}
+
+TEST(Compress, budget) {
+    // 16 MiB of zeros compresses to very little
+    const std::string zeros(16 << 20, 0);
+    for(uint8_t const alg : {OpenPGP::Compression::ID::ZIP, OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}) {
+        const std::string bomb = OpenPGP::Compression::compress(alg, zeros);
+
+        std::size_t received = 0, largest = 0;
+        const OpenPGP::Compression::Sink count = [&](const std::string & piece) {
+            received += piece.size();
+            largest = std::max(largest, piece.size());
+            return true;
+        };
+
+        // no limit
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, bomb, count), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(received, zeros.size());
+        EXPECT_LE(largest, 16384);
+
+        // stops at the output limit
+        received = 0;
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, bomb, count, OpenPGP::Compression::Budget(1 << 20)), OpenPGP::Status::DECOMPRESSION_OUTPUT_LIMIT);
+        EXPECT_LE(received, 1 << 20);
+
+        // stops at the ratio limit
+        received = 0;
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, bomb, count, OpenPGP::Compression::Budget(0, 100)), OpenPGP::Status::DECOMPRESSION_RATIO_LIMIT);
+        EXPECT_LT(received, zeros.size());
+
+        // corrupt and truncated data
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, bomb.substr(0, bomb.size() / 2), count), OpenPGP::Status::INVALID_COMPRESSED_DATA);
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, std::string(100, 'x'), count), OpenPGP::Status::INVALID_COMPRESSED_DATA);
+    }
+
+    EXPECT_EQ(OpenPGP::Compression::decompress(200, "", [](const std::string &) { return true; }), OpenPGP::Status::INVALID_COMPRESSION_ALGORITHM);
+}
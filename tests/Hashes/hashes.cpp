@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "Hashes/Hashes.h"
+
+#include "../testvectors/msg.h"
+
+namespace {
+
+struct Digest {
+    typedef std::string result_type;
+
+    const std::string & data;
+
+    template <typename H>
+    std::string operator()(H & ctx) const {
+        ctx.H::update(data);
+        return ctx.digest();
+    }
+};
+
+}
+
+TEST(Hashes, dispatch) {
+    for(std::pair <const std::string, uint8_t> const & alg : OpenPGP::Hash::NUMBER) {
+        const std::string expected = OpenPGP::Hash::get_instance(alg.second, MESSAGE) -> digest();
+        EXPECT_EQ(OpenPGP::Hash::dispatch(alg.second, Digest{MESSAGE}), expected);
+        EXPECT_EQ(OpenPGP::Hash::use(alg.second, MESSAGE), expected);
+    }
+
+    EXPECT_THROW(OpenPGP::Hash::dispatch(4, Digest{MESSAGE}), std::runtime_error);
+}
+
+TEST(Hashes, length) {
+    for(std::pair <const uint8_t, std::size_t> const & alg : OpenPGP::Hash::LENGTH) {
+        EXPECT_EQ(OpenPGP::Hash::length(alg.first), alg.second);
+        EXPECT_EQ(OpenPGP::Hash::use(alg.first).size(), alg.second >> 3);
+    }
+
+    EXPECT_THROW(OpenPGP::Hash::length(4), std::runtime_error);
+}
+
+TEST(Hashes, context) {
+    OpenPGP::Hash::Context <OpenPGP::Hash::ID::SHA256> ctx;
+    ctx.update(MESSAGE.substr(0, 3));
+    ctx.update(MESSAGE.substr(3));
+    EXPECT_EQ(ctx.digest(), OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE));
+    EXPECT_EQ(ctx.digestsize(), OpenPGP::Hash::Traits <OpenPGP::Hash::ID::SHA256>::LENGTH);
+}
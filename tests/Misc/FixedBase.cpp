@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "Misc/FixedBase.h"
+#include "Misc/mpi.h"
+
+TEST(FixedBase, powm_sec) {
+    for(std::size_t const bits : {64, 160, 256}) {
+        const OpenPGP::MPI mod  = OpenPGP::random(512) | 1;
+        const OpenPGP::MPI base = OpenPGP::random(511);
+        const OpenPGP::FixedBase table(base, mod, bits);
+
+        EXPECT_EQ(table.powm_sec(0), 1);
+        EXPECT_EQ(table.powm_sec(1), base % mod);
+
+        for(int i = 0; i < 10; i++) {
+            const OpenPGP::MPI exp = OpenPGP::random(bits);
+            EXPECT_EQ(table.powm_sec(exp), OpenPGP::powm_pub(base, exp, mod));
+        }
+
+        // exponent does not fit in the table
+        OpenPGP::MPI too_big = 1;
+        too_big <<= bits;
+        EXPECT_THROW(table.powm_sec(too_big), std::runtime_error);
+    }
+}
+
+TEST(FixedBase, matches) {
+    const OpenPGP::FixedBase table(3, 101, 8);
+    EXPECT_TRUE(table.matches(3, 101));
+    EXPECT_FALSE(table.matches(5, 101));
+    EXPECT_FALSE(table.matches(3, 103));
+    EXPECT_THROW(OpenPGP::FixedBase(3, 100, 8), std::runtime_error);
+}
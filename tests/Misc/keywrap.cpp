@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "Misc/keywrap.h"
+
+TEST(keywrap, rfc3394) {
+    // 4.1 Wrap 128 bits of Key Data with a 128-bit KEK
+    const std::string kek128 = unhexlify("000102030405060708090a0b0c0d0e0f");
+    const std::string key128 = unhexlify("00112233445566778899aabbccddeeff");
+    const std::string wrapped128 = unhexlify("1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5");
+    EXPECT_EQ(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::AES128, key128, kek128), wrapped128);
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, wrapped128, kek128), key128);
+
+    // 4.6 Wrap 256 bits of Key Data with a 256-bit KEK
+    const std::string kek256 = unhexlify("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const std::string key256 = unhexlify("00112233445566778899aabbccddeeff000102030405060708090a0b0c0d0e0f");
+    const std::string wrapped256 = unhexlify("28c9f404c4b810f4cbccb35cfb87f8263f5786e2d80ed326cbc7f0e71a99f43bfb988b9b7a02dd21");
+    EXPECT_EQ(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::AES256, key256, kek256), wrapped256);
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES256, wrapped256, kek256), key256);
+}
+
+TEST(keywrap, integrity) {
+    const std::string kek = unhexlify("000102030405060708090a0b0c0d0e0f");
+    std::string wrapped = unhexlify("1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5");
+    wrapped[10] ^= 1;
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, wrapped, kek), "");
+
+    // not a multiple of 8 octets
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, wrapped.substr(1), kek), "");
+}
@@ -111,3 +111,27 @@ TEST(MPI, read_write) {
         EXPECT_EQ(OpenPGP::read_MPI(str, pos), value);
     }
 }
+
+TEST(MPI, powm) {
+    for (int i = 0; i < COUNT; ++i) {
+        const OpenPGP::MPI mod  = OpenPGP::random(256) | 1;
+        const OpenPGP::MPI base = OpenPGP::random(255);
+        const OpenPGP::MPI exp  = OpenPGP::random(128) + 1;
+        EXPECT_EQ(OpenPGP::powm_pub(base, exp, mod), OpenPGP::powm_sec(base, exp, mod));
+        EXPECT_EQ(OpenPGP::powm(base, exp, mod), OpenPGP::powm_sec(base, exp, mod));
+    }
+}
+
+TEST(MPI, powm2) {
+    for (int i = 0; i < COUNT; ++i) {
+        const OpenPGP::MPI mod = OpenPGP::random(256) | 1;
+        const OpenPGP::MPI b1  = OpenPGP::random(255);
+        const OpenPGP::MPI b2  = OpenPGP::random(255);
+        const OpenPGP::MPI e1  = OpenPGP::random(160);
+        const OpenPGP::MPI e2  = OpenPGP::random(100 + i);
+        const OpenPGP::MPI expected = (OpenPGP::powm_pub(b1, e1, mod) * OpenPGP::powm_pub(b2, e2, mod)) % mod;
+        EXPECT_EQ(OpenPGP::powm2_pub(b1, e1, b2, e2, mod), expected);
+    }
+
+    EXPECT_EQ(OpenPGP::powm2_pub(5, 0, 7, 0, 11), 1);
+}
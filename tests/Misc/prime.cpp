@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "Misc/mpi.h"
+#include "Misc/prime.h"
+
+TEST(Prime, random) {
+    for(std::size_t const bits : {3, 16, 64, 256, 512}) {
+        for(unsigned int const threads : {1, 4}) {
+            const OpenPGP::MPI prime = OpenPGP::Prime::random(bits, threads);
+            EXPECT_EQ(OpenPGP::bitsize(prime), bits);
+            EXPECT_TRUE(OpenPGP::knuth_prime_test(prime, 25));
+        }
+    }
+
+    // product of two primes has exactly twice the bits
+    const OpenPGP::MPI p = OpenPGP::Prime::random(128);
+    const OpenPGP::MPI q = OpenPGP::Prime::random(128);
+    EXPECT_EQ(OpenPGP::bitsize(p * q), (std::size_t) 256);
+
+    EXPECT_THROW(OpenPGP::Prime::random(2), std::runtime_error);
+}
+
+TEST(Prime, progression) {
+    const OpenPGP::MPI q = OpenPGP::Prime::random(160);
+    const OpenPGP::MPI start = (OpenPGP::random(1024) / q) * q + 1;
+
+    for(unsigned int const threads : {1, 3}) {
+        const OpenPGP::MPI p = OpenPGP::Prime::progression(start, q, threads);
+        EXPECT_TRUE(OpenPGP::knuth_prime_test(p, 25));
+        EXPECT_GE(p, start);
+        EXPECT_EQ((p - 1) % q, 0);
+    }
+
+    // small values
+    EXPECT_EQ(OpenPGP::Prime::progression(8, 3), 11);
+    EXPECT_EQ(OpenPGP::Prime::progression(2, 1), 2);
+
+    // no primes possible
+    EXPECT_THROW(OpenPGP::Prime::progression(10, 4), std::runtime_error);
+}
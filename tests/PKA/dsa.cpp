@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <set>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 
 #include "PKA/DSA.h"
@@ -21,6 +25,7 @@ TEST(DSA, dsa_siggen) {
     auto p = OpenPGP::hextompi(DSA_SIGGEN_P);
     auto q = OpenPGP::hextompi(DSA_SIGGEN_Q);
     auto g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    const OpenPGP::FixedBase::Ptr g_table = OpenPGP::PKA::DSA::precompute({p, q, g});
     for ( unsigned int i = 0; i < DSA_SIGGEN_MSG.size(); ++i ) {
         auto digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA1, unhexlify(DSA_SIGGEN_MSG[i]));
         auto x = OpenPGP::hextompi(DSA_SIGGEN_X[i]);
@@ -30,6 +35,7 @@ TEST(DSA, dsa_siggen) {
         auto s = OpenPGP::hextompi(DSA_SIGGEN_S[i]);
         const OpenPGP::PKA::Values sig = {r, s};
         EXPECT_EQ(OpenPGP::PKA::DSA::sign(digest, {x}, {p, q, g, y}, k), sig);
+        EXPECT_EQ(OpenPGP::PKA::DSA::sign(digest, {x}, {p, q, g, y}, k, g_table), sig);
         EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA1, PKA_DSA, {p, q, g, y}, sig), true);
 
         //! test random k
@@ -56,3 +62,79 @@ TEST(DSA, keygen) {
         EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
     }
 }
+
+TEST(DSA, precompute_mismatch) {
+    auto p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    auto q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    auto g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    auto x = OpenPGP::hextompi(DSA_SIGGEN_X[0]);
+    auto y = OpenPGP::hextompi(DSA_SIGGEN_Y[0]);
+
+    const OpenPGP::FixedBase::Ptr other = OpenPGP::PKA::DSA::precompute({p, q, g + 1});
+    EXPECT_THROW(OpenPGP::PKA::DSA::sign(std::string("data"), {x}, {p, q, g, y}, 0, other), std::runtime_error);
+}
+
+TEST(DSA, nonce_pool) {
+    auto p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    auto q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    auto g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    auto x = OpenPGP::hextompi(DSA_SIGGEN_X[0]);
+    auto y = OpenPGP::hextompi(DSA_SIGGEN_Y[0]);
+    const OpenPGP::PKA::Values pub = {p, q, g, y};
+
+    // same signature as signing with k directly
+    auto k = OpenPGP::hextompi(DSA_SIGGEN_K[0]);
+    const OpenPGP::PKA::DSA::Nonce fixed = {OpenPGP::invert(k, q), OpenPGP::powm_sec(g, k, p) % q};
+    auto digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA1, unhexlify(DSA_SIGGEN_MSG[0]));
+    const OpenPGP::PKA::Values expected = {OpenPGP::hextompi(DSA_SIGGEN_R[0]), OpenPGP::hextompi(DSA_SIGGEN_S[0])};
+    EXPECT_EQ(OpenPGP::PKA::DSA::sign(OpenPGP::rawtompi(digest), {x}, pub, fixed), expected);
+
+    const OpenPGP::FixedBase::Ptr g_table = OpenPGP::PKA::DSA::precompute(pub);
+    OpenPGP::PKA::DSA::Pool pool([pub, g_table]() { return OpenPGP::PKA::DSA::nonce(pub, g_table); }, 8);
+
+    std::set <OpenPGP::MPI> rs;
+    for(int i = 0; i < 20; i++) {
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::DSA::sign(digest, {x}, pub, pool);
+        EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
+        rs.insert(sig[0]);
+    }
+
+    // nonces are never reused
+    EXPECT_EQ(rs.size(), (std::size_t) 20);
+}
+
+TEST(NoncePool, refill) {
+    std::atomic <int> made(0);
+
+    // low is at least 1, so a pool of 1 refills after every take()
+    OpenPGP::PKA::NoncePool <int> pool([&made]() { return made++; }, 1);
+    for(int i = 0; i < 5; i++) {
+        pool.take();
+        for(int wait = 0; (pool.size() < 1) && (wait < 1000); wait++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(pool.size(), (std::size_t) 1);
+    }
+}
+
+TEST(NoncePool, generator_throws) {
+    std::atomic <int> made(0);
+    OpenPGP::PKA::NoncePool <int> pool([&made]() {
+        const int n = made++;
+        if (n >= 2) {
+            throw std::runtime_error("Error: No more nonces.");
+        }
+        return n;
+    }, 2);
+    for(int wait = 0; (pool.size() < 2) && (wait < 1000); wait++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // the values made before the failure are still handed out
+    std::set <int> values;
+    for(int i = 0; i < 2; i++) {
+        values.insert(pool.take());
+    }
+    EXPECT_EQ(values, std::set <int> ({0, 1}));
+    EXPECT_THROW(pool.take(), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "PKA/ECDSA.h"
+#include "sign.h"
+
+static const std::string P256 = "\x2A\x86\x48\xCE\x3D\x03\x01\x07";
+static const std::string P384("\x2B\x81\x04\x00\x22", 5);
+
+// RFC 6979 sec A.2.5 and A.2.6, message "sample"
+struct ECDSA_Vector {
+    std::string curve;
+    uint8_t hash;
+    std::string x, Ux, Uy, k, r, s;
+};
+
+static const std::vector <ECDSA_Vector> ECDSA_SAMPLE = {
+    {
+        P256,
+        OpenPGP::Hash::ID::SHA256,
+        "C9AFA9D845BA75166B5C215767B1D6934E50C3DB36E89B127B8A622B120F6721",
+        "60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6",
+        "7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299",
+        "A6E3C57DD01ABE90086538398355DD4C3B17AA873382B0F24D6129493D8AAD60",
+        "EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716",
+        "F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8",
+    },
+    {
+        P384,
+        OpenPGP::Hash::ID::SHA384,
+        "6B9D3DAD2E1B8C1C05B19875B6659F4DE23C3B667BF297BA9AA47740787137D896D5724E4C70A825F872C9EA60D2EDF5",
+        "EC3A4E415B4E19A4568618029F427FA5DA9A8BC4AE92E02E06AAE5286B300C64DEF8F0EA9055866064A254515480BC13",
+        "8015D9B72D7D57244EA8EF9AC0C621896708A59367F9DFB9F54CA84B3F1C9DB1288B231C3AE0D4FE7344FD2533264720",
+        "94ED910D1A099DAD3254E9242AE85ABDE4BA15168EAF0CA87A555FD56D10FBCA2907E3E83BA95368623B8C4686915CF9",
+        "94EDBB92A5ECB8AAD4736E56C691916B3F88140666CE9FA73D64C4EA95AD133C81A648152E44ACF96E36DD1E80FABE46",
+        "99EF4AEB15F178CEA1FE40DB2603138F130E740A19624526203B6351D0A3A94FA329C145786E679E7B82C71A38628AC8",
+    },
+};
+
+TEST(ECDSA, rfc6979) {
+    for(ECDSA_Vector const & v : ECDSA_SAMPLE) {
+        const OpenPGP::PKA::Values pri = {OpenPGP::hextompi(v.x)};
+        const OpenPGP::PKA::Values pub = {OpenPGP::hextompi("04" + v.Ux + v.Uy)};
+        const OpenPGP::PKA::Values expected = {OpenPGP::hextompi(v.r), OpenPGP::hextompi(v.s)};
+        const std::string digest = OpenPGP::Hash::use(v.hash, "sample");
+
+        ASSERT_EQ(OpenPGP::PKA::ECDSA::supported(v.curve), true);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::sign(digest, pri, pub, v.curve, OpenPGP::hextompi(v.k)), expected);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, expected, pub, v.curve), true);
+
+        // random k
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::ECDSA::sign(digest, pri, pub, v.curve);
+        ASSERT_EQ(sig.size(), 2);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, sig, pub, v.curve), true);
+
+        // wrong message, r, s, and key
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(OpenPGP::Hash::use(v.hash, "test"), expected, pub, v.curve), false);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, {expected[0] + 1, expected[1]}, pub, v.curve), false);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, {expected[0], expected[1] + 1}, pub, v.curve), false);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, expected, {pub[0] + 1}, v.curve), false);
+    }
+}
+
+TEST(ECDSA, keygen) {
+    for(std::string const & curve : {P256, P384}) {
+        OpenPGP::PKA::Values pub;
+        const OpenPGP::PKA::Values pri = OpenPGP::PKA::ECDSA::keygen(curve, pub);
+        ASSERT_EQ(pub.size(), 1);
+        ASSERT_EQ(pri.size(), 1);
+
+        const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA512, "The quick brown fox jumps over the lazy dog");
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::ECDSA::sign(digest, pri, pub, curve);
+        ASSERT_EQ(sig.size(), 2);
+        EXPECT_EQ(OpenPGP::PKA::ECDSA::verify(digest, sig, pub, curve), true);
+
+        #ifdef GPG_COMPATIBLE
+        const uint8_t PKA_ECDSA = OpenPGP::PKA::ID::ECDSA;
+        const OpenPGP::PKA::Values new_sig = OpenPGP::Sign::with_pka(digest, PKA_ECDSA, pri, pub, OpenPGP::Hash::ID::SHA512, curve);
+        EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA512, PKA_ECDSA, pub, new_sig, curve), true);
+        #endif
+    }
+
+    // P-521
+    const std::string P521("\x2B\x81\x04\x00\x23", 5);
+    OpenPGP::PKA::Values pub;
+    EXPECT_EQ(OpenPGP::PKA::ECDSA::supported(P521), false);
+    EXPECT_EQ(OpenPGP::PKA::ECDSA::keygen(P521, pub).size(), 0);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "PKA/Ed25519.h"
+#include "PKA/EdDSA.h"
+#include "sign.h"
+
+// RFC 8032 sec 7.1
+static const std::vector <std::string> ED25519_SEED = {
+    "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+    "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+    "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+    "833fe62409237b9d62ec77587520911e9a759cec1d19755b7da901b96dca3d42",
+};
+
+static const std::vector <std::string> ED25519_PUB = {
+    "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+    "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+    "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+    "ec172b93ad5e563bf4932c70e1245034c35467ef2efd4d64ebf819683467e2bf",
+};
+
+static const std::vector <std::string> ED25519_MSG = {
+    "",
+    "72",
+    "af82",
+    "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+};
+
+static const std::vector <std::string> ED25519_SIG = {
+    "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+    "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00",
+    "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a",
+    "dc2a4459e7369633a52b1bf277839a00201009a3efbf3ecb69bea2186c26b58909351fc9ac90b3ecfdfbc7c66431e0303dca179c138ac17ad9bef1177331a704",
+};
+
+TEST(Ed25519, rfc8032) {
+
+    ASSERT_EQ(ED25519_SEED.size(), ED25519_PUB.size());
+    ASSERT_EQ(ED25519_PUB.size(),  ED25519_MSG.size());
+    ASSERT_EQ(ED25519_MSG.size(),  ED25519_SIG.size());
+
+    for ( unsigned int i = 0; i < ED25519_SEED.size(); ++i ) {
+        const std::string seed = unhexlify(ED25519_SEED[i]);
+        const std::string pub  = unhexlify(ED25519_PUB[i]);
+        const std::string msg  = unhexlify(ED25519_MSG[i]);
+        const std::string sig  = unhexlify(ED25519_SIG[i]);
+
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::public_key(seed), pub);
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::sign(msg, seed), sig);
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::sign(msg, seed, pub), sig);
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::verify(msg, sig, pub), true);
+
+        // flip one bit each in the message, R, and S
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::verify(msg + std::string(1, 0), sig, pub), false);
+        std::string bad = sig;
+        bad[0] ^= 1;
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::verify(msg, bad, pub), false);
+        bad = sig;
+        bad[32] ^= 1;
+        EXPECT_EQ(OpenPGP::PKA::Ed25519::verify(msg, bad, pub), false);
+    }
+}
+
+TEST(Ed25519, non_canonical_s) {
+    const std::string seed = unhexlify(ED25519_SEED[1]);
+    const std::string pub  = unhexlify(ED25519_PUB[1]);
+    const std::string msg  = unhexlify(ED25519_MSG[1]);
+    const std::string sig  = unhexlify(ED25519_SIG[1]);
+
+    // S + L is an equivalent scalar but must be rejected
+    const OpenPGP::MPI L = (OpenPGP::MPI(1) << 252) + OpenPGP::MPI("27742317777372353535851937790883648493");
+    const OpenPGP::MPI S = OpenPGP::rawtompi(little_end(sig.substr(32), 256)) + L;
+    const std::string malleated = sig.substr(0, 32) + little_end(zfill(OpenPGP::mpitoraw(S), 32, 0), 256);
+    EXPECT_EQ(OpenPGP::PKA::Ed25519::verify(msg, malleated, pub), false);
+}
+
+TEST(EdDSA, keygen) {
+    OpenPGP::PKA::Values pub;
+    const OpenPGP::PKA::Values pri = OpenPGP::PKA::EdDSA::keygen(pub);
+    ASSERT_EQ(pub.size(), 1);
+    ASSERT_EQ(pri.size(), 1);
+
+    const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, "The quick brown fox jumps over the lazy dog");
+    const OpenPGP::PKA::Values sig = OpenPGP::PKA::EdDSA::sign(digest, pri, pub);
+    ASSERT_EQ(sig.size(), 2);
+    EXPECT_EQ(OpenPGP::PKA::EdDSA::verify(digest, sig, pub), true);
+    EXPECT_EQ(OpenPGP::PKA::EdDSA::verify(digest + std::string(1, 0), sig, pub), false);
+
+    #ifdef GPG_COMPATIBLE
+    const uint8_t PKA_EdDSA = OpenPGP::PKA::ID::EdDSA;
+    const std::string ED25519 = unhexlify(OpenPGP::PKA::CURVE_OID::ED_255);
+    const OpenPGP::PKA::Values new_sig = OpenPGP::Sign::with_pka(digest, PKA_EdDSA, pri, pub, OpenPGP::Hash::ID::SHA256, ED25519);
+    EXPECT_EQ(new_sig, sig);    // deterministic
+    EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA256, PKA_EdDSA, pub, new_sig, ED25519), true);
+
+    // the point is only an Ed25519 key on Ed25519
+    const std::string P256 = unhexlify(OpenPGP::PKA::CURVE_OID::NIST_256);
+    EXPECT_EQ(OpenPGP::Sign::with_pka(digest, PKA_EdDSA, pri, pub, OpenPGP::Hash::ID::SHA256, P256).size(), 0);
+    EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA256, PKA_EdDSA, pub, new_sig, P256), -1);
+    EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA256, PKA_EdDSA, pub, new_sig), -1);
+    #endif
+}
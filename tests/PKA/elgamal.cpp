@@ -23,5 +23,17 @@ TEST(ElGamal, keygen) {
 
         // convert to mpi to ignore missing leading zeros
         EXPECT_EQ(mpi_data, OpenPGP::rawtompi(decrypted));
+
+        // precomputed generator
+        const OpenPGP::FixedBase::Ptr g_table = OpenPGP::PKA::ElGamal::precompute(pub);
+        const OpenPGP::PKA::Values encrypted_table = OpenPGP::PKA::ElGamal::encrypt(data, pub, g_table);
+        EXPECT_EQ(mpi_data, OpenPGP::rawtompi(OpenPGP::PKA::ElGamal::decrypt(encrypted_table, pri, pub)));
+
+        // background nonces
+        OpenPGP::PKA::ElGamal::Pool pool([pub, g_table]() { return OpenPGP::PKA::ElGamal::nonce(pub, g_table); }, 4);
+        for(int i = 0; i < 6; i++) {
+            const OpenPGP::PKA::Values encrypted_pool = OpenPGP::PKA::ElGamal::encrypt(data, pub, pool);
+            EXPECT_EQ(mpi_data, OpenPGP::rawtompi(OpenPGP::PKA::ElGamal::decrypt(encrypted_pool, pri, pub)));
+        }
     }
 }
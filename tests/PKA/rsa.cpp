@@ -34,6 +34,8 @@ TEST(RSA, keygen) {
     OpenPGP::PKA::Values pub = {key[0], key[1]};
     OpenPGP::PKA::Values pri = {key[2], key[3], key[4], key[5]};
 
+    EXPECT_EQ(key[1], 65537);
+
     auto encrypted = OpenPGP::PKA::RSA::encrypt(MESSAGE, pub);
     auto decrypted = OpenPGP::PKA::RSA::decrypt(encrypted, pri, pub);
     EXPECT_EQ(decrypted, OpenPGP::rawtompi(MESSAGE));
@@ -41,3 +43,45 @@ TEST(RSA, keygen) {
     auto signature = OpenPGP::PKA::RSA::sign(MESSAGE, pri, pub);
     EXPECT_TRUE(OpenPGP::PKA::RSA::verify(MESSAGE, {signature}, pub));
 }
+
+TEST(RSA, crt) {
+    OpenPGP::PKA::Values key = OpenPGP::PKA::RSA::keygen(512);
+    OpenPGP::PKA::Values pub = {key[0], key[1]};
+    OpenPGP::PKA::Values pri = {key[2], key[3], key[4], key[5]};
+
+    ASSERT_TRUE(OpenPGP::PKA::RSA::has_crt(pri, pub));
+    OpenPGP::PKA::Values d_only = {key[2]};
+    EXPECT_FALSE(OpenPGP::PKA::RSA::has_crt(d_only, pub));
+
+    const OpenPGP::PKA::RSA::CRT crt(pri);
+    const OpenPGP::MPI data = OpenPGP::rawtompi(MESSAGE) % pub[0];
+
+    // CRT and plain exponentiation agree
+    const OpenPGP::MPI plain = OpenPGP::powm(data, key[2], key[0]);
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(data, pri, pub, true), plain);
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(data, crt, pub, true), plain);
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(data, d_only, pub, true), plain);
+
+    // a faulty half is caught by the public key check
+    OpenPGP::PKA::RSA::CRT faulty = crt;
+    faulty.dQ += 1;
+    EXPECT_NO_THROW(OpenPGP::PKA::RSA::sign(data, faulty, pub, false));
+    EXPECT_THROW(OpenPGP::PKA::RSA::sign(data, faulty, pub, true), std::runtime_error);
+    EXPECT_THROW(OpenPGP::PKA::RSA::sign(data, faulty, pub), std::runtime_error);
+
+    // a wrong u is not used for CRT
+    OpenPGP::PKA::Values bad_u = pri;
+    bad_u[3] = OpenPGP::invert(pri[2], pri[1]);
+    EXPECT_FALSE(OpenPGP::PKA::RSA::has_crt(bad_u, pub));
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(data, bad_u, pub), plain);
+}
+
+TEST(RSA, keygen_exponent) {
+    OpenPGP::PKA::Values key = OpenPGP::PKA::RSA::keygen(512, 3);
+    ASSERT_EQ(key.size(), (std::size_t) 6);
+    EXPECT_EQ(key[1], 3);
+    EXPECT_EQ((key[1] * key[2]) % ((key[3] - 1) * (key[4] - 1)), 1);
+
+    // even exponents are rejected
+    EXPECT_EQ(OpenPGP::PKA::RSA::keygen(512, 4).size(), (std::size_t) 0);
+}
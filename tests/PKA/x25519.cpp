@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "PKA/ECDH.h"
+#include "PKA/X25519.h"
+
+TEST(X25519, rfc7748) {
+    // RFC 7748 sec 5.2
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::scalarmult(unhexlify("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4"),
+                                                       unhexlify("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c"))),
+              "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552");
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::scalarmult(unhexlify("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d"),
+                                                       unhexlify("e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493"))),
+              "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957");
+
+    // RFC 7748 sec 6.1
+    const std::string a = unhexlify("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    const std::string b = unhexlify("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+    const std::string A = OpenPGP::PKA::X25519::public_key(a);
+    const std::string B = OpenPGP::PKA::X25519::public_key(b);
+    EXPECT_EQ(hexlify(A), "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a");
+    EXPECT_EQ(hexlify(B), "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f");
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::scalarmult(a, B)), "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742");
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::scalarmult(b, A)), "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742");
+}
+
+TEST(ECDH, encrypt_decrypt) {
+    OpenPGP::PKA::Values pub;
+    const OpenPGP::PKA::Values pri = OpenPGP::PKA::ECDH::keygen(pub);
+    ASSERT_EQ(pub.size(), 1);
+    ASSERT_EQ(pri.size(), 1);
+
+    const std::string curve = unhexlify("2B060104019755010501");
+    const uint8_t hash = OpenPGP::Hash::ID::SHA256;
+    const uint8_t sym = OpenPGP::Sym::ID::AES128;
+    const std::string param = OpenPGP::PKA::ECDH::param(curve, hash, sym, std::string(20, '\x01'));
+
+    // algorithm || 16 octet key || checksum
+    const std::string data = "\x09" + std::string(16, '\x5a') + "\x05\xa0";
+
+    std::string wrapped;
+    const OpenPGP::PKA::Values c = OpenPGP::PKA::ECDH::encrypt(data, pub, hash, sym, param, wrapped);
+    ASSERT_EQ(c.size(), 1);
+    EXPECT_EQ(wrapped.size(), 32);
+    EXPECT_EQ(OpenPGP::PKA::ECDH::decrypt(c, wrapped, pri, hash, sym, param), data);
+
+    // different fingerprint -> different KEK
+    const std::string other = OpenPGP::PKA::ECDH::param(curve, hash, sym, std::string(20, '\x02'));
+    EXPECT_EQ(OpenPGP::PKA::ECDH::decrypt(c, wrapped, pri, hash, sym, other), "");
+}
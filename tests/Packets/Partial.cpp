@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include "Message.h"
+#include "Misc/Length.h"
 #include "Packets/Packets.h"
 #include "Packets/Partial.h"
 
@@ -88,3 +90,88 @@ TEST(Partial, can_have_partial_length_ptr) {
     EXPECT_FALSE(Partial::can_have_partial_length(std::make_shared <Tag62> ()));
     EXPECT_FALSE(Partial::can_have_partial_length(std::make_shared <Tag63> ()));
 }
+
+TEST(Partial, writer) {
+    using namespace OpenPGP::Packet;
+
+    EXPECT_THROW(PartialWriter([](const std::string &) {}, SIGNATURE), std::runtime_error);
+    EXPECT_THROW(PartialWriter([](const std::string &) {}, LITERAL_DATA, 8), std::runtime_error);
+
+    // 2.5 chunks of literal data, written in odd sized pieces
+    Tag11 tag11;
+    tag11.set_data_format('b');
+    tag11.set_filename("filename");
+    tag11.set_time(0);
+    tag11.set_literal(std::string(1280, 'a'));
+    const std::string body = tag11.raw();
+
+    std::string out;
+    PartialWriter writer([&out](const std::string & data) { out += data; }, LITERAL_DATA, 9);
+    for(std::string::size_type i = 0; i < body.size(); i += 100) {
+        writer.write(body.substr(i, 100));
+    }
+    writer.finish();
+    EXPECT_THROW(writer.write("a"), std::runtime_error);
+
+    EXPECT_EQ(out.substr(0, 2), "\xcb\xe9");
+    EXPECT_EQ(out[514], '\xe9');
+
+    OpenPGP::Message msg(out);
+    ASSERT_EQ(msg.get_packets().size(), (std::size_t) 1);
+    const Tag11::Ptr read = std::static_pointer_cast <Tag11> (msg.get_packets()[0]);
+    EXPECT_EQ(read -> get_partial(), PARTIAL);
+    EXPECT_EQ(read -> get_filename(), "filename");
+    EXPECT_EQ(read -> get_literal(), std::string(1280, 'a'));
+
+    // short bodies are written with a normal length
+    out.clear();
+    PartialWriter small([&out](const std::string & data) { out += data; }, LITERAL_DATA);
+    small.write(body.substr(0, 20));
+    small.finish();
+    EXPECT_EQ(out, OpenPGP::write_new_length(LITERAL_DATA, body.substr(0, 20), NOT_PARTIAL));
+}
+
+TEST(Partial, reader) {
+    using namespace OpenPGP::Packet;
+
+    // old format, new format with partial body lengths, and an empty packet
+    std::string literal;
+    PartialWriter writer([&literal](const std::string & data) { literal += data; }, LITERAL_DATA, 9);
+    writer.write(std::string(1500, 'a'));
+    writer.finish();
+
+    const std::string data = OpenPGP::write_old_length(MARKER_PACKET, "PGP", NOT_PARTIAL) +
+                             literal +
+                             OpenPGP::write_new_length(USER_ID, "", NOT_PARTIAL);
+
+    std::vector <std::pair <uint8_t, std::string> > packets;
+    PacketReader reader([&packets](const uint8_t tag, const std::string & body, const bool last) {
+        if (packets.empty() || packets.back().first != tag) {
+            packets.emplace_back(tag, "");
+        }
+        packets.back().second += body;
+        if (last) {
+            packets.emplace_back(0, "");
+        }
+    });
+
+    // one octet at a time
+    for(char const c : data) {
+        reader.update(std::string(1, c));
+    }
+    EXPECT_TRUE(reader.idle());
+    EXPECT_NO_THROW(reader.finish());
+
+    ASSERT_EQ(packets.size(), (std::size_t) 6);
+    EXPECT_EQ(packets[0], std::make_pair(MARKER_PACKET, std::string("PGP")));
+    EXPECT_EQ(packets[2], std::make_pair(LITERAL_DATA, std::string(1500, 'a')));
+    EXPECT_EQ(packets[4].first, USER_ID);
+
+    // bad header and truncated data
+    EXPECT_THROW(reader.update("\x01"), std::runtime_error);
+
+    PacketReader truncated([](const uint8_t, const std::string &, const bool) {});
+    truncated.update(literal.substr(0, 100));
+    EXPECT_FALSE(truncated.idle());
+    EXPECT_THROW(truncated.finish(), std::runtime_error);
+}
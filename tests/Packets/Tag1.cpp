@@ -92,6 +92,25 @@ TEST(Tag1, read_write) {
 
         EXPECT_EQ(tag1.raw(), raw);
     }
+
+    #ifdef GPG_COMPATIBLE
+    // ECDH
+    {
+        const uint8_t ecdh_pka = OpenPGP::PKA::ID::ECDH;
+        const std::string point = OpenPGP::write_MPI(0x40);
+        const std::string wrapped(24, '\x01');
+        const std::string raw = std::string(1, version) + keyid + std::string(1, ecdh_pka) + point + std::string(1, wrapped.size()) + wrapped;
+
+        OpenPGP::Packet::Tag1 tag1(raw);
+        EXPECT_EQ(tag1.get_mpi(), OpenPGP::PKA::Values({0x40}));
+        EXPECT_EQ(tag1.get_wrapped(), wrapped);
+        EXPECT_EQ(tag1.raw(), raw);
+
+        // the wrapped key is cut short or missing
+        EXPECT_THROW(OpenPGP::Packet::Tag1(raw.substr(0, raw.size() - 1)), std::runtime_error);
+        EXPECT_THROW(OpenPGP::Packet::Tag1(raw.substr(0, raw.size() - wrapped.size() - 1)), std::runtime_error);
+    }
+    #endif
 }
 
 TEST(Tag1, show) {
@@ -70,6 +70,48 @@ TEST(Tag8, read_write) {
     EXPECT_EQ(tag8.raw(), raw);
 }
 
+TEST(Tag8, cache) {
+    OpenPGP::Packet::Tag8 tag8;
+    EXPECT_NO_THROW(TAG8_FILL(tag8, OpenPGP::Compression::ID::ZLIB));
+    const std::string compressed = tag8.get_compressed_data();
+    EXPECT_NE(compressed, MESSAGE);
+
+    // parsing keeps the original compressed octets
+    OpenPGP::Packet::Tag8 str(tag8.raw());
+    TAG8_EQ(str, OpenPGP::Compression::ID::ZLIB);
+    EXPECT_EQ(str.get_compressed_data(), compressed);
+
+    // setting the same data does not recompress
+    str.set_data(MESSAGE);
+    EXPECT_EQ(str.get_compressed_data(), compressed);
+
+    // changing the algorithm or the data does
+    str.set_comp(OpenPGP::Compression::ID::BZIP2);
+    TAG8_EQ(str, OpenPGP::Compression::ID::BZIP2);
+    EXPECT_EQ(OpenPGP::Compression::decompress(OpenPGP::Compression::ID::BZIP2, str.get_compressed_data()), MESSAGE);
+
+    str.set_data(MESSAGE + MESSAGE);
+    EXPECT_EQ(OpenPGP::Compression::decompress(OpenPGP::Compression::ID::BZIP2, str.get_compressed_data()), MESSAGE + MESSAGE);
+
+    // setting compressed data replaces the uncompressed data
+    str.set_comp(OpenPGP::Compression::ID::ZLIB);
+    str.set_compressed_data(compressed);
+    TAG8_EQ(str, OpenPGP::Compression::ID::ZLIB);
+}
+
+TEST(Tag8, stream) {
+    OpenPGP::Packet::Tag8 tag8;
+    EXPECT_NO_THROW(TAG8_FILL(tag8, OpenPGP::Compression::ID::ZIP));
+    OpenPGP::Packet::Tag8 str(tag8.raw());
+
+    std::string data;
+    const OpenPGP::Compression::Sink append = [&data](const std::string & piece) { data += piece; return true; };
+    EXPECT_EQ(str.get_data(append, OpenPGP::Compression::Budget()), OpenPGP::Status::SUCCESS);
+    EXPECT_EQ(data, MESSAGE);
+
+    EXPECT_EQ(str.get_data(append, OpenPGP::Compression::Budget(MESSAGE.size() - 1)), OpenPGP::Status::DECOMPRESSION_OUTPUT_LIMIT);
+}
+
 // TEST(Tag8, show) {
 //     OpenPGP::Packet::Tag8 tag8;
 //     EXPECT_NO_THROW(TAG8_FILL(tag8, OpenPGP::Compression::ID::UNCOMPRESSED));
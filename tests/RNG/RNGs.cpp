@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "RNG/RNGs.h"
+
+TEST(RNG, rand_mpi) {
+    EXPECT_EQ(OpenPGP::RNG::rand_mpi(0), 0);
+
+    for(unsigned int bits : {1u, 7u, 8u, 9u, 63u, 64u, 65u, 1024u}) {
+        const OpenPGP::MPI limit = OpenPGP::MPI(1) << bits;
+        bool top = false;
+        for(int i = 0; i < 64; i++) {
+            const OpenPGP::MPI r = OpenPGP::RNG::rand_mpi(bits);
+            EXPECT_GE(r, 0);
+            EXPECT_LT(r, limit);
+            top |= (OpenPGP::bitsize(r) == bits);
+        }
+
+        // the highest bit is reachable
+        EXPECT_EQ(top, true);
+    }
+}
+
+TEST(RNG, rand_range) {
+    EXPECT_THROW(OpenPGP::RNG::rand_range(0), std::runtime_error);
+    EXPECT_THROW(OpenPGP::RNG::rand_range(1), std::runtime_error);
+    EXPECT_EQ(OpenPGP::RNG::rand_range(2), 1);
+
+    // every value of [1, 5) shows up
+    std::size_t seen[5] = {};
+    for(int i = 0; i < 400; i++) {
+        const OpenPGP::MPI r = OpenPGP::RNG::rand_range(5);
+        ASSERT_GE(r, 1);
+        ASSERT_LT(r, 5);
+        seen[r.get_ui()]++;
+    }
+    EXPECT_EQ(seen[0], 0);
+    for(std::size_t i = 1; i < 5; i++) {
+        EXPECT_GT(seen[i], 0);
+    }
+
+    const OpenPGP::MPI q = OpenPGP::hextompi("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551");
+    for(int i = 0; i < 64; i++) {
+        const OpenPGP::MPI r = OpenPGP::RNG::rand_range(q);
+        EXPECT_GE(r, 1);
+        EXPECT_LT(r, q);
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "RNG/RNGs.h"
+
+#if !defined(OPENSSL_RNG) && !defined(BBS_RNG)
+
+#include <set>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common/includes.h"
+
+TEST(ChaCha20, block) {
+    // RFC 8439 sec 2.3.2
+    const std::string key   = unhexlify("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const std::string nonce = unhexlify("000000090000004a00000000");
+    EXPECT_EQ(hexlify(OpenPGP::RNG::ChaCha20::block(key, 1, nonce)),
+              "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+              "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+}
+
+TEST(ChaCha20, output) {
+    OpenPGP::RNG::RNG rng;
+    for(unsigned int len : {0u, 1u, 31u, 32u, 33u, 991u, 992u, 993u, 1000u, 5000u}) {
+        EXPECT_EQ(rng.rand_bytes(len).size(), len);
+    }
+
+    EXPECT_NE(rng.rand_bytes(32), rng.rand_bytes(32));
+
+    const std::string bits = rng.rand_bits(13);
+    EXPECT_EQ(bits.size(), 13);
+    EXPECT_EQ(bits.find_first_not_of("01"), std::string::npos);
+
+    // extra seed material only adds entropy
+    OpenPGP::RNG::RNG seeded("seed");
+    EXPECT_NE(seeded.rand_bytes(32), OpenPGP::RNG::RNG("seed").rand_bytes(32));
+}
+
+TEST(ChaCha20, threads) {
+    // every thread has its own generator; none may repeat another's output
+    const std::size_t THREADS = 8;
+    std::vector <std::string> out(THREADS);
+    std::vector <std::thread> threads;
+    for(std::size_t i = 0; i < THREADS; i++) {
+        threads.emplace_back([&out, i](){
+            for(std::size_t j = 0; j < 100; j++) {
+                out[i] += OpenPGP::RNG::RNG().rand_bytes(16);
+            }
+        });
+    }
+    for(std::thread & t : threads) {
+        t.join();
+    }
+
+    std::set <std::string> blocks;
+    for(std::string const & o : out) {
+        ASSERT_EQ(o.size(), 1600);
+        for(std::size_t i = 0; i < o.size(); i += 16) {
+            blocks.insert(o.substr(i, 16));
+        }
+    }
+    EXPECT_EQ(blocks.size(), THREADS * 100);
+}
+
+TEST(ChaCha20, fork) {
+    OpenPGP::RNG::RNG rng;
+    rng.rand_bytes(32);
+
+    // parent and child continue from the same state, but must not
+    // produce the same octets
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        const std::string out = OpenPGP::RNG::RNG().rand_bytes(32);
+        _exit(write(fds[1], out.data(), out.size()) != 32);
+    }
+
+    const std::string parent = rng.rand_bytes(32);
+    std::string child(32, 0);
+    EXPECT_EQ(read(fds[0], &child[0], child.size()), 32);
+    close(fds[0]);
+    close(fds[1]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_NE(parent, child);
+}
+
+#endif
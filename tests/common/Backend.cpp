@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "common/Backend.h"
+#include "Encryptions/Encryptions.h"
+#include "Hashes/Hashes.h"
+
+using namespace OpenPGP;
+
+TEST(Backend, select) {
+    const uint8_t original = Backend::get();
+
+    EXPECT_TRUE(Backend::available(Backend::ID::BUILTIN));
+    EXPECT_TRUE(Backend::set(Backend::ID::BUILTIN));
+    EXPECT_EQ(Backend::get(), Backend::ID::BUILTIN);
+
+    EXPECT_EQ(Backend::set(Backend::ID::OPENSSL), Backend::available(Backend::ID::OPENSSL));
+    EXPECT_FALSE(Backend::set(0xff));
+
+    Backend::set(original);
+}
+
+TEST(Backend, hashes) {
+    const uint8_t original = Backend::get();
+    const std::string data = "The quick brown fox jumps over the lazy dog";
+
+    for(std::pair <const uint8_t, std::size_t> const & hash : Hash::LENGTH) {
+        ASSERT_TRUE(Backend::set(Backend::ID::BUILTIN));
+        const std::string builtin = Hash::use(hash.first, data);
+        EXPECT_EQ(builtin.size(), hash.second >> 3);
+
+        if (Backend::set(Backend::ID::OPENSSL)) {
+            EXPECT_EQ(Hash::use(hash.first, data), builtin);
+
+            Hash::Instance instance = Hash::get_instance(hash.first, data.substr(0, 10));
+            instance -> update(data.substr(10));
+            EXPECT_EQ(instance -> digest(), builtin);
+            EXPECT_EQ(instance -> digest(), builtin);
+            EXPECT_EQ(instance -> digestsize(), hash.second);
+        }
+    }
+
+    Backend::set(original);
+}
+
+TEST(Backend, context) {
+    const uint8_t original = Backend::get();
+    const std::string data = "The quick brown fox jumps over the lazy dog";
+
+    ASSERT_TRUE(Backend::set(Backend::ID::BUILTIN));
+    const std::string builtin = Hash::use(Hash::ID::SHA256, data);
+
+    if (Backend::set(Backend::ID::OPENSSL)) {
+        Hash::Context <Hash::ID::SHA256> ctx(data.substr(0, 10));
+        ctx.update(data.substr(10));
+        EXPECT_EQ(ctx.digest(), builtin);
+        EXPECT_EQ(ctx.digestsize(), Hash::Traits <Hash::ID::SHA256>::LENGTH);
+    }
+
+    Backend::set(original);
+}
+
+TEST(Backend, ciphers) {
+    const uint8_t original = Backend::get();
+
+    for(std::pair <const uint8_t, std::size_t> const & sym : Sym::KEY_LENGTH) {
+        std::string key(sym.second >> 3, 0);
+        for(std::size_t i = 0; i < key.size(); i++) {
+            key[i] = i * 7 + 1;
+        }
+
+        const std::string block(Sym::BLOCK_LENGTH.at(sym.first) >> 3, 'A');
+
+        ASSERT_TRUE(Backend::set(Backend::ID::BUILTIN));
+        const std::string builtin = Sym::setup(sym.first, key) -> encrypt(block);
+        EXPECT_EQ(builtin.size(), block.size());
+
+        if (Backend::set(Backend::ID::OPENSSL)) {
+            SymAlg::Ptr alg = Sym::setup(sym.first, key);
+            EXPECT_EQ(alg -> blocksize(), Sym::BLOCK_LENGTH.at(sym.first));
+            EXPECT_EQ(alg -> encrypt(block), builtin);
+            EXPECT_EQ(alg -> decrypt(builtin), block);
+        }
+    }
+
+    Backend::set(original);
+}
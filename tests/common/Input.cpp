@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+#include "common/Input.h"
+
+static std::string pattern(const std::size_t size) {
+    std::string data(size, 0);
+    for(std::size_t i = 0; i < size; i++) {
+        data[i] = static_cast <char> (i * 7 + (i >> 12));
+    }
+    return data;
+}
+
+TEST(Input, file) {
+    char filename[] = "/tmp/InputXXXXXX";
+    const int fd = mkstemp(filename);
+    ASSERT_GE(fd, 0);
+
+    const std::string data = pattern(100000);
+    ASSERT_EQ(write(fd, data.data(), data.size()), (ssize_t) data.size());
+
+    // read from the start, not the current offset
+    std::string in;
+    OpenPGP::from_fd(fd, [&in](const char * piece, const std::size_t len) { in.append(piece, len); });
+    EXPECT_EQ(in, data);
+
+    in.clear();
+    OpenPGP::from_file(filename, [&in](const char * piece, const std::size_t len) { in.append(piece, len); });
+    EXPECT_EQ(in, data);
+
+    // empty file
+    ASSERT_EQ(ftruncate(fd, 0), 0);
+    in.clear();
+    OpenPGP::from_fd(fd, [&in](const char * piece, const std::size_t len) { in.append(piece, len); });
+    EXPECT_EQ(in, "");
+
+    close(fd);
+    unlink(filename);
+
+    EXPECT_THROW(OpenPGP::from_file(filename, [](const char *, const std::size_t) {}), std::runtime_error);
+}
+
+TEST(Input, pipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // more than one buffer
+    const std::string data = pattern(5 << 20);
+    std::thread writer([&]() {
+        std::size_t done = 0;
+        while (done < data.size()) {
+            const ssize_t rc = write(fds[1], data.data() + done, data.size() - done);
+            if (rc <= 0) {
+                break;
+            }
+            done += rc;
+        }
+        close(fds[1]);
+    });
+
+    std::string in;
+    OpenPGP::from_fd(fds[0], [&in](const char * piece, const std::size_t len) { in.append(piece, len); });
+    writer.join();
+    close(fds[0]);
+
+    EXPECT_EQ(in == data, true);
+}
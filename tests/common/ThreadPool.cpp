@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "common/ThreadPool.h"
+
+TEST(ThreadPool, run) {
+    OpenPGP::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), (std::size_t) 4);
+
+    std::atomic <int> count(0);
+    for(int i = 0; i < 1000; i++) {
+        pool.submit([&count]() { count++; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 1000);
+
+    // reusable after wait
+    pool.submit([&count]() { count++; });
+    pool.wait();
+    EXPECT_EQ(count, 1001);
+}
+
+TEST(ThreadPool, in_worker) {
+    OpenPGP::ThreadPool pool(2), other(1);
+    EXPECT_FALSE(pool.in_worker());
+
+    std::atomic <bool> own(false), others(true);
+    pool.submit([&]() {
+        own = pool.in_worker();
+        others = other.in_worker();
+    });
+    pool.wait();
+    EXPECT_TRUE(own);
+    EXPECT_FALSE(others);
+}
+
+TEST(ThreadPool, exception) {
+    OpenPGP::ThreadPool pool(2);
+
+    std::atomic <int> count(0);
+    pool.submit([]() { throw std::runtime_error("task"); });
+    for(int i = 0; i < 10; i++) {
+        pool.submit([&count]() { count++; });
+    }
+
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(count, 10);
+
+    // the error is only reported once
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(ThreadPool, destructor) {
+    std::atomic <int> count(0);
+    {
+        OpenPGP::ThreadPool pool(1);
+        for(int i = 0; i < 100; i++) {
+            pool.submit([&count]() { count++; });
+        }
+    }
+    EXPECT_EQ(count, 100);
+}
@@ -3,7 +3,7 @@
 
 #include "Message.h"
 
-std::string extract_decrypted(const OpenPGP::Message & decrypted) {
+inline std::string extract_decrypted(const OpenPGP::Message & decrypted) {
     std::string message = "";
     for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
         switch (p -> get_tag()) {
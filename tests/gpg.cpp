@@ -619,6 +619,46 @@ TEST(gpg, decrypt_pka_no_mdc) {
     EXPECT_EQ(extract_decrypted(decrypted), MESSAGE);
 }
 
+#ifdef GPG_COMPATIBLE
+TEST(gpg, decrypt_pka_ecdh) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Bobpri", pri, GPG_DIR), true);
+
+    OpenPGP::PublicKey pub;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Bobpub", pub, GPG_DIR), true);
+
+    OpenPGP::Message gpg_encrypted;
+    ASSERT_EQ(read_pgp <OpenPGP::Message> ("pkaencrypted25519", gpg_encrypted, GPG_DIR), true);
+
+    // tag 1
+    {
+        const OpenPGP::PGP::Packets packets = gpg_encrypted.get_packets();
+        ASSERT_EQ(packets.size(), (OpenPGP::PGP::Packets::size_type) 2);
+        ASSERT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY);
+        const OpenPGP::Packet::Tag1::Ptr tag1 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag1> (packets[0]);
+        EXPECT_EQ(tag1 -> get_keyid(), "\x29\x9a\x2c\x58\xb4\x60\xb9\x7b");
+        EXPECT_EQ(tag1 -> get_pka(), OpenPGP::PKA::ID::ECDH);
+        ASSERT_EQ(tag1 -> get_mpi().size(), (OpenPGP::PKA::Values::size_type) 1);
+        EXPECT_EQ(OpenPGP::bitsize(tag1 -> get_mpi()[0]), (std::size_t) 263);
+        EXPECT_EQ(tag1 -> get_wrapped().size(), (std::string::size_type) 48);
+        EXPECT_EQ(OpenPGP::Packet::Tag1(tag1 -> raw()).raw(), tag1 -> raw());
+    }
+
+    // decrypt data
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, PASSPHRASE, gpg_encrypted);
+    EXPECT_EQ(extract_decrypted(decrypted), MESSAGE);
+
+    // round trip through the public key
+    // with a pinned level, since MESSAGE is too short to be compressed automatically
+    OpenPGP::Encrypt::Args args("", MESSAGE);
+    args.level = Z_DEFAULT_COMPRESSION;
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(args, pub);
+    ASSERT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(extract_decrypted(OpenPGP::Decrypt::pka(pri, PASSPHRASE, encrypted)), MESSAGE);
+}
+#endif
+
 TEST(gpg, decrypt_symmetric_mdc) {
 
     OpenPGP::Message gpg_encrypted;
@@ -882,3 +922,71 @@ TEST(gpg, verify_cleartext) {
 
     EXPECT_EQ(OpenPGP::Verify::cleartext_signature(pri, clearsig), true);
 }
+
+TEST(gpg, verify_batch) {
+
+    OpenPGP::PublicKey pub;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", pub, GPG_DIR), true);
+
+    OpenPGP::DetachedSignature detached;
+    ASSERT_EQ(read_pgp <OpenPGP::DetachedSignature> ("detached", detached, GPG_DIR), true);
+
+    const OpenPGP::Packet::Key::Ptr signing_key = OpenPGP::find_signing_key(pub);
+    ASSERT_NE(signing_key, nullptr);
+
+    // self certifications on the primary key
+    std::vector <OpenPGP::Verify::Job> certifications;
+    OpenPGP::Packet::Key::Ptr primary = nullptr;
+    OpenPGP::Packet::User::Ptr user = nullptr;
+    for(OpenPGP::Packet::Tag::Ptr const & packet : pub.get_packets()) {
+        if (OpenPGP::Packet::is_primary_key(packet -> get_tag())) {
+            primary = std::static_pointer_cast <OpenPGP::Packet::Key> (packet);
+        }
+        else if (OpenPGP::Packet::is_user(packet -> get_tag())) {
+            user = std::static_pointer_cast <OpenPGP::Packet::User> (packet);
+        }
+        else if ((packet -> get_tag() == OpenPGP::Packet::SIGNATURE) && user) {
+            const OpenPGP::Packet::Tag2::Ptr sig = std::static_pointer_cast <OpenPGP::Packet::Tag2> (packet);
+            if (OpenPGP::Signature_Type::is_certification(sig -> get_type())) {
+                certifications.emplace_back(primary, primary, user, sig);
+            }
+        }
+    }
+    ASSERT_FALSE(certifications.empty());
+
+    // detached signature over a precomputed digest
+    const OpenPGP::Packet::Tag2::Ptr detached_sig = std::static_pointer_cast <OpenPGP::Packet::Tag2> (detached.get_packets()[0]);
+    const OpenPGP::Verify::Job good(signing_key, detached_sig, OpenPGP::to_sign_00(OpenPGP::binary_to_canonical(MESSAGE), detached_sig));
+    const OpenPGP::Verify::Job bad(signing_key, detached_sig, OpenPGP::to_sign_00(OpenPGP::binary_to_canonical(MESSAGE + "x"), detached_sig));
+    const OpenPGP::Verify::Job incomplete;
+
+    std::vector <OpenPGP::Verify::Job> jobs;
+    std::vector <int> expected;
+    for(std::size_t i = 0; i < 8; i++) {
+        for(OpenPGP::Verify::Job const & job : certifications) {
+            jobs.push_back(job);
+            expected.push_back(true);
+        }
+        jobs.push_back(good);
+        expected.push_back(true);
+        jobs.push_back(bad);
+        expected.push_back(false);
+        jobs.push_back(incomplete);
+        expected.push_back(-1);
+    }
+
+    for(std::size_t const threads : {1, 4}) {
+        EXPECT_EQ(OpenPGP::Verify::batch(jobs, threads), expected);
+    }
+
+    OpenPGP::ThreadPool pool(3);
+    EXPECT_EQ(OpenPGP::Verify::batch(jobs, pool), expected);
+    EXPECT_EQ(OpenPGP::Verify::batch({}, pool).size(), (std::size_t) 0);
+
+    // from a task on the same pool, with no other thread free
+    OpenPGP::ThreadPool single(1);
+    std::vector <int> nested;
+    single.submit([&]() { nested = OpenPGP::Verify::batch(jobs, single); });
+    single.wait();
+    EXPECT_EQ(nested, expected);
+}
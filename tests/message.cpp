@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include "Message.h"
@@ -117,3 +118,69 @@ TEST(Message, symencryptednomdc) {
 // TEST(Message, signature) {
 //     TEST_PGP(OpenPGP::Message, dir + "signature");
 // }
+
+TEST(Message, compressed) {
+    OpenPGP::Packet::Tag11::Ptr literal = std::make_shared <OpenPGP::Packet::Tag11> ();
+    literal -> set_data_format('b');
+    literal -> set_literal("The quick brown fox jumps over the lazy dog");
+
+    OpenPGP::Packet::Tag8 tag8;
+    tag8.set_comp(OpenPGP::Compression::ID::ZLIB);
+    tag8.set_data(literal -> write());
+
+    // the compressed packet is written back as read, and only once
+    OpenPGP::Message msg(tag8.write());
+    EXPECT_EQ(msg.get_comp(), OpenPGP::Compression::ID::ZLIB);
+    EXPECT_EQ(msg.raw(), tag8.write());
+    EXPECT_EQ(msg.write(OpenPGP::PGP::Armored::NO), tag8.write());
+}
+
+TEST(Message, reader_nested_compression) {
+    OpenPGP::Packet::Tag11 literal;
+    literal.set_data_format('b');
+    literal.set_literal(std::string(8 << 20, '\0'));
+    const std::string literal_packet = literal.write();
+
+    OpenPGP::Packet::Tag8 inner;
+    inner.set_comp(OpenPGP::Compression::ID::ZLIB);
+    inner.set_data(literal_packet);
+    const std::string inner_packet = inner.write();
+
+    OpenPGP::Packet::Tag8 outer;
+    outer.set_comp(OpenPGP::Compression::ID::ZLIB);
+    outer.set_data(inner_packet);
+    const std::string outer_packet = outer.write();
+
+    // each layer on its own stays under the ratio, but not both together
+    const double inner_ratio = static_cast <double> (literal_packet.size()) / inner.get_compressed_data().size();
+    const double outer_ratio = static_cast <double> (inner_packet.size()) / outer.get_compressed_data().size();
+    const OpenPGP::Compression::Budget budget(0, 2 * std::max(inner_ratio, outer_ratio));
+    ASSERT_GT(inner_ratio * outer_ratio, budget.max_ratio);
+
+    std::size_t received = 0;
+    const OpenPGP::Output count = [&](const std::string & piece) {
+        received += piece.size();
+    };
+
+    {
+        OpenPGP::MessageReader reader(count, nullptr, budget);
+        EXPECT_EQ(reader.update(inner_packet), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(reader.finish(), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(received, 8 << 20);
+    }
+
+    received = 0;
+    {
+        OpenPGP::MessageReader reader(count, nullptr, budget);
+        EXPECT_EQ(reader.update(outer_packet), OpenPGP::Status::DECOMPRESSION_RATIO_LIMIT);
+        EXPECT_LT(received, 8 << 20);
+    }
+
+    received = 0;
+    {
+        OpenPGP::MessageReader reader(count);
+        EXPECT_EQ(reader.update(outer_packet), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(reader.finish(), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(received, 8 << 20);
+    }
+}
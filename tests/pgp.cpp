@@ -2,6 +2,8 @@
 #include <ctime>
 #include <sstream>
 
+#include <unistd.h>
+
 #include <gtest/gtest.h>
 
 #include "decrypt.h"
@@ -12,6 +14,7 @@
 #include "verify.h"
 
 #include "arm_key.h"
+#include "extract_decrypted.h"
 #include "testvectors/msg.h"
 #include "testvectors/pass.h"
 #include "read_pgp.h"
@@ -265,14 +268,35 @@ TEST(PGP, revoke_uid) {
     EXPECT_EQ(OpenPGP::Revoke::check(dirrevuid), true);
 }
 
+// MESSAGE is too short for Compression::LEVEL_AUTO to compress, so pin the
+// level to keep the Compressed Data Packet path covered; comp is the
+// algorithm Encrypt used
+static void force_compression(OpenPGP::Encrypt::Args & args, uint8_t & comp) {
+    args.level = Z_DEFAULT_COMPRESSION;
+    args.observer = [&comp](const OpenPGP::Compression::Decision & decision) { comp = decision.alg; };
+}
+
+// several partial body chunks of compressible data for the stream tests
+static std::string stream_data() {
+    std::string data;
+    while (data.size() < 70000) {
+        data += MESSAGE + std::to_string(data.size());
+    }
+    return data;
+}
+
 TEST(PGP, encrypt_decrypt_pka_mdc) {
 
     OpenPGP::SecretKey pri;
     ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
 
-    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    uint8_t comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    force_compression(encrypt_args, comp);
+
     const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encrypt_args, pri);
     EXPECT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(comp, OpenPGP::Compression::ID::ZLIB);
 
     const OpenPGP::PGP::Packets packets = encrypted.get_packets();
     EXPECT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY);
@@ -302,9 +326,12 @@ TEST(PGP, encrypt_decrypt_pka_no_mdc) {
     OpenPGP::Encrypt::Args encrypt_args;
     encrypt_args.data = MESSAGE;
     encrypt_args.mdc = false;
+    uint8_t comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    force_compression(encrypt_args, comp);
 
     const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encrypt_args, pri);
     EXPECT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(comp, OpenPGP::Compression::ID::ZLIB);
 
     const OpenPGP::PGP::Packets packets = encrypted.get_packets();
     EXPECT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY);
@@ -328,9 +355,13 @@ TEST(PGP, encrypt_decrypt_pka_no_mdc) {
 
 TEST(PGP, encrypt_decrypt_symmetric_mdc) {
 
-    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    uint8_t comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    force_compression(encrypt_args, comp);
+
     const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
     EXPECT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(comp, OpenPGP::Compression::ID::ZLIB);
 
     const OpenPGP::PGP::Packets packets = encrypted.get_packets();
     EXPECT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY);
@@ -354,9 +385,12 @@ TEST(PGP, encrypt_decrypt_symmetric_no_mdc) {
     OpenPGP::Encrypt::Args encrypt_args;
     encrypt_args.data = MESSAGE;
     encrypt_args.mdc = false;
+    uint8_t comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    force_compression(encrypt_args, comp);
 
     const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
     EXPECT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(comp, OpenPGP::Compression::ID::ZLIB);
 
     const OpenPGP::PGP::Packets packets = encrypted.get_packets();
     EXPECT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY);
@@ -384,9 +418,12 @@ TEST(PGP, encrypt_sign_decrypt_verify) {
     encrypt_args.data = MESSAGE;
     encrypt_args.signer = std::make_shared <OpenPGP::SecretKey> (pri);
     encrypt_args.passphrase = PASSPHRASE;
+    uint8_t comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    force_compression(encrypt_args, comp);
 
     const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encrypt_args, pri);
     EXPECT_EQ(encrypted.meaningful(), true);
+    EXPECT_EQ(comp, OpenPGP::Compression::ID::ZLIB);
 
     const OpenPGP::PGP::Packets packets = encrypted.get_packets();
     EXPECT_EQ(packets[0] -> get_tag(), OpenPGP::Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY);
@@ -475,6 +512,157 @@ TEST(PGP, new_partial_body_length) {
     EXPECT_EQ(tag11 -> get_literal(), literal);
 }
 
+TEST(PGP, encrypt_stream) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
+
+    const std::string data = stream_data();
+
+    for(uint8_t const comp : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZLIB}) {
+        for(bool const mdc : {true, false}) {
+            OpenPGP::Encrypt::Args encrypt_args;
+            encrypt_args.filename = "stream";
+            encrypt_args.comp = comp;
+            encrypt_args.mdc = mdc;
+
+            // passphrase
+            std::stringstream sym_out;
+            {
+                OpenPGP::Encrypt::Stream stream(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256, OpenPGP::to_stream(sym_out));
+                for(std::string::size_type i = 0; i < data.size(); i += 4099) {
+                    stream.update(data.substr(i, 4099));
+                }
+                stream.finish();
+            }
+
+            const OpenPGP::Message sym_encrypted(sym_out.str());
+            ASSERT_EQ(sym_encrypted.meaningful(), true);
+            EXPECT_EQ(sym_encrypted.get_packets()[1] -> get_tag(), mdc?OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA);
+            EXPECT_EQ(extract_decrypted(OpenPGP::Decrypt::sym(sym_encrypted, PASSPHRASE)), data);
+
+            // public key, with everything in one update
+            std::stringstream pka_out;
+            {
+                OpenPGP::Encrypt::Stream stream(encrypt_args, pri, OpenPGP::to_stream(pka_out));
+                stream.update(data);
+                stream.finish();
+            }
+
+            const OpenPGP::Message pka_encrypted(pka_out.str());
+            ASSERT_EQ(pka_encrypted.meaningful(), true);
+            EXPECT_EQ(extract_decrypted(OpenPGP::Decrypt::pka(pri, PASSPHRASE, pka_encrypted)), data);
+        }
+    }
+
+    // empty data
+    std::stringstream empty_out;
+    OpenPGP::Encrypt::Stream empty(OpenPGP::Encrypt::Args(), PASSPHRASE, OpenPGP::Hash::ID::SHA256, OpenPGP::to_stream(empty_out));
+    empty.finish();
+    EXPECT_THROW(empty.update("data"), std::runtime_error);
+    EXPECT_EQ(extract_decrypted(OpenPGP::Decrypt::sym(OpenPGP::Message(empty_out.str()), PASSPHRASE)), "");
+
+    // signed
+    OpenPGP::Encrypt::Args sign_args;
+    sign_args.signer = std::make_shared <OpenPGP::SecretKey> (pri);
+    sign_args.passphrase = PASSPHRASE;
+
+    std::stringstream signed_out;
+    OpenPGP::Encrypt::Stream sign_stream(sign_args, pri, OpenPGP::to_stream(signed_out));
+    sign_stream.update(data);
+    sign_stream.finish();
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, PASSPHRASE, OpenPGP::Message(signed_out.str()));
+    EXPECT_EQ(extract_decrypted(decrypted), data);
+    EXPECT_EQ(OpenPGP::Verify::binary(pri, decrypted), true);
+
+    sign_args.signer = std::make_shared <OpenPGP::SecretKey> ();
+    EXPECT_THROW(OpenPGP::Encrypt::Stream(sign_args, pri, OpenPGP::to_stream(signed_out)), std::runtime_error);
+}
+
+TEST(PGP, decrypt_stream) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
+
+    const std::string data = stream_data();
+
+    // decrypt in small pieces
+    auto decrypt = [](OpenPGP::Decrypt::Stream & stream, const std::string & encrypted) {
+        for(std::string::size_type i = 0; i < encrypted.size(); i += 1000) {
+            stream.update(encrypted.substr(i, 1000));
+        }
+        return stream.finish();
+    };
+
+    for(uint8_t const comp : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}) {
+        for(bool const mdc : {true, false}) {
+            OpenPGP::Encrypt::Args encrypt_args;
+            encrypt_args.comp = comp;
+            encrypt_args.mdc = mdc;
+
+            // streamed with partial body lengths
+            std::stringstream streamed;
+            {
+                OpenPGP::Encrypt::Stream stream(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256, OpenPGP::to_stream(streamed));
+                stream.update(data);
+                stream.finish();
+            }
+
+            std::string out;
+            OpenPGP::Decrypt::Stream sym_stream(PASSPHRASE, [&out](const std::string & piece) { out += piece; });
+            EXPECT_EQ(decrypt(sym_stream, streamed.str()), OpenPGP::Status::SUCCESS);
+            EXPECT_EQ(out, data);
+
+            // in one packet
+            encrypt_args.data = data;
+            const std::string whole = OpenPGP::Encrypt::pka(encrypt_args, pri).raw();
+
+            out.clear();
+            OpenPGP::Decrypt::Stream pka_stream(pri, PASSPHRASE, [&out](const std::string & piece) { out += piece; });
+            EXPECT_EQ(decrypt(pka_stream, whole), OpenPGP::Status::SUCCESS);
+            EXPECT_EQ(out, data);
+        }
+    }
+
+    OpenPGP::Encrypt::Args encrypt_args("", data);
+    encrypt_args.comp = OpenPGP::Compression::ID::UNCOMPRESSED;
+    const std::string encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256).raw();
+    const OpenPGP::Output discard = [](const std::string &) {};
+
+    // modified ciphertext
+    std::string modified = encrypted;
+    modified[modified.size() / 2] ^= 1;
+    OpenPGP::Decrypt::Stream modified_stream(PASSPHRASE, discard);
+    EXPECT_EQ(decrypt(modified_stream, modified), OpenPGP::Status::INVALID_SHA1_HASH);
+
+    // truncated
+    OpenPGP::Decrypt::Stream truncated_stream(PASSPHRASE, discard);
+    EXPECT_EQ(decrypt(truncated_stream, encrypted.substr(0, encrypted.size() - 10)), OpenPGP::Status::INVALID_LENGTH);
+
+    // no usable session key
+    OpenPGP::Decrypt::Stream pka_stream(pri, PASSPHRASE, discard);
+    EXPECT_EQ(decrypt(pka_stream, encrypted), OpenPGP::Status::MISSING_SESSION_KEY);
+
+    // malformed session key packets are skipped: a PKESK whose MPI is cut
+    // off and an SKESK whose salt is cut off
+    const std::string bad_pkesk = std::string("\xc1\x0b\x03", 3) + std::string(8, '\x00') + std::string("\x01\x00", 2);
+    const std::string bad_skesk("\xc3\x03\x04\x09\x01", 5);
+
+    OpenPGP::Decrypt::Stream bad_pkesk_stream(pri, PASSPHRASE, discard);
+    EXPECT_EQ(decrypt(bad_pkesk_stream, bad_pkesk), OpenPGP::Status::MISSING_SESSION_KEY);
+
+    OpenPGP::Decrypt::Stream bad_skesk_stream(PASSPHRASE, discard);
+    EXPECT_EQ(decrypt(bad_skesk_stream, bad_skesk + encrypted), OpenPGP::Status::SUCCESS);
+
+    // from a std::istream
+    std::string out;
+    std::stringstream in(encrypted);
+    OpenPGP::Decrypt::Stream read_stream(PASSPHRASE, [&out](const std::string & piece) { out += piece; });
+    EXPECT_EQ(read_stream.read(in), OpenPGP::Status::SUCCESS);
+    EXPECT_EQ(out, data);
+}
+
 TEST(PGP, sign_verify_detached) {
 
     OpenPGP::SecretKey pri;
@@ -483,6 +671,21 @@ TEST(PGP, sign_verify_detached) {
     const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE);
     const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, MESSAGE);
     EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+
+    // signed data in a file
+    char filename[] = "/tmp/detachedXXXXXX";
+    const int fd = mkstemp(filename);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, MESSAGE.data(), MESSAGE.size()), (ssize_t) MESSAGE.size());
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, fd, sig), true);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature_file(pri, filename, sig), true);
+
+    ASSERT_EQ(write(fd, "\n", 1), 1);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, fd, sig), false);
+
+    close(fd);
+    unlink(filename);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature_file(pri, filename, sig), -1);
 }
 
 TEST(PGP, sign_verify_binary) {
@@ -495,6 +698,140 @@ TEST(PGP, sign_verify_binary) {
     EXPECT_EQ(OpenPGP::Verify::binary(pri, sig), true);
 }
 
+TEST(PGP, sign_stream) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
+
+    const std::string data = stream_data();
+
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA256);
+    for(uint8_t const comp : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZLIB}) {
+        std::stringstream out;
+        OpenPGP::Sign::Stream stream(sign_args, "stream", OpenPGP::to_stream(out), comp);
+        for(std::string::size_type i = 0; i < data.size(); i += 4099) {
+            stream.update(data.substr(i, 4099));
+        }
+        stream.finish();
+        EXPECT_THROW(stream.update("data"), std::runtime_error);
+
+        EXPECT_EQ(out.str()[0] & 0x3f, comp?OpenPGP::Packet::COMPRESSED_DATA:OpenPGP::Packet::ONE_PASS_SIGNATURE);
+
+        const OpenPGP::Message sig(out.str());
+        ASSERT_EQ(sig.meaningful(), true);
+        EXPECT_EQ(extract_decrypted(sig), data);
+        EXPECT_EQ(OpenPGP::Verify::binary(pri, sig), true);
+    }
+
+    // no signing key
+    std::stringstream out;
+    EXPECT_THROW(OpenPGP::Sign::Stream(OpenPGP::Sign::Args(OpenPGP::SecretKey(), PASSPHRASE), "", OpenPGP::to_stream(out)), std::runtime_error);
+}
+
+// feed a binary message to a Verify::Stream in pieces
+static OpenPGP::Status verify_stream(OpenPGP::Verify::Stream & stream, const std::string & message) {
+    for(std::string::size_type i = 0; i < message.size(); i += 1000) {
+        if (stream.update(message.substr(i, 1000)) != OpenPGP::Status::SUCCESS) {
+            break;
+        }
+    }
+    return stream.finish();
+}
+
+TEST(PGP, verify_stream) {
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri, GPG_DIR), true);
+
+    const std::string data = stream_data();
+
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA256);
+    std::string signed_message;
+    for(uint8_t const comp : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZLIB}) {
+        std::stringstream out;
+        OpenPGP::Sign::Stream sign(sign_args, "stream", OpenPGP::to_stream(out), comp);
+        sign.update(data);
+        sign.finish();
+
+        std::stringstream literal;
+        OpenPGP::Verify::Stream stream(pri, OpenPGP::to_stream(literal));
+        EXPECT_EQ(stream.read(out), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(stream.verified(), true);
+        EXPECT_EQ(stream.get_results().size(), 1);
+        EXPECT_EQ(literal.str(), data);
+
+        if (comp == OpenPGP::Compression::ID::UNCOMPRESSED) {
+            signed_message = out.str();
+        }
+    }
+
+    // nested one-pass signatures and a signature in front of the message
+    const OpenPGP::PGP::Packets inner = OpenPGP::Sign::binary(sign_args, "", MESSAGE, OpenPGP::Compression::ID::UNCOMPRESSED).get_packets();
+    const OpenPGP::PGP::Packets outer = OpenPGP::Sign::binary(OpenPGP::Sign::Args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA512), "", MESSAGE, OpenPGP::Compression::ID::UNCOMPRESSED).get_packets();
+    ASSERT_EQ(inner.size(), 3);
+    ASSERT_EQ(outer.size(), 3);
+    std::static_pointer_cast <OpenPGP::Packet::Tag4> (outer[0]) -> set_last(0);
+
+    {
+        OpenPGP::Verify::Stream stream(pri);
+        EXPECT_EQ(verify_stream(stream, outer[0] -> write() + inner[0] -> write() + inner[1] -> write() + inner[2] -> write() + outer[2] -> write()), OpenPGP::Status::SUCCESS);
+        ASSERT_EQ(stream.get_results().size(), 2);
+        EXPECT_EQ(stream.get_results()[0].status, true);
+        EXPECT_EQ(stream.get_results()[1].status, true);
+    }
+
+    {
+        OpenPGP::Verify::Stream stream(pri);
+        EXPECT_EQ(verify_stream(stream, outer[2] -> write() + inner[1] -> write()), OpenPGP::Status::SUCCESS);
+        EXPECT_EQ(stream.verified(), true);
+    }
+
+    // missing Signature Packet
+    {
+        OpenPGP::Verify::Stream stream(pri);
+        EXPECT_EQ(verify_stream(stream, outer[0] -> write() + inner[0] -> write() + inner[1] -> write() + inner[2] -> write()), OpenPGP::Status::INVALID);
+        EXPECT_EQ(stream.verified(), -1);
+    }
+
+    // malformed Signature and One-Pass Signature Packets
+    {
+        const std::string sig = inner[2] -> raw();
+        ASSERT_EQ(sig[0], 4);
+
+        std::string bad_subpacket = sig.substr(0, 40);
+        bad_subpacket[6] = '\xff';
+
+        std::string bad_hashed = sig.substr(0, 40);
+        bad_hashed[4] = bad_hashed[5] = '\xff';
+
+        const std::string bad_v3("\x03\x05\x00\x00\x00\x00\x00\x00\x00\x00", 10);
+
+        const std::string bad_one_pass = inner[0] -> raw().substr(0, 12);
+
+        for(std::string const & body : {bad_subpacket, bad_hashed, bad_v3}) {
+            OpenPGP::Verify::Stream stream(pri);
+            const std::string packet = std::string(1, '\xc0' | OpenPGP::Packet::SIGNATURE) + std::string(1, body.size()) + body;
+            EXPECT_EQ(stream.update(packet), OpenPGP::Status::INVALID);
+            EXPECT_EQ(stream.update(inner[1] -> write()), OpenPGP::Status::INVALID);
+            EXPECT_EQ(stream.finish(), OpenPGP::Status::INVALID);
+            EXPECT_EQ(stream.verified(), -1);
+        }
+
+        OpenPGP::Verify::Stream stream(pri);
+        const std::string packet = std::string(1, '\xc0' | OpenPGP::Packet::ONE_PASS_SIGNATURE) + std::string(1, bad_one_pass.size()) + bad_one_pass;
+        EXPECT_EQ(verify_stream(stream, packet + inner[1] -> write() + inner[2] -> write()), OpenPGP::Status::INVALID);
+    }
+
+    // modified literal data
+    signed_message[signed_message.size() / 2] ^= 1;
+    OpenPGP::Verify::Stream stream(pri);
+    EXPECT_EQ(verify_stream(stream, signed_message), OpenPGP::Status::SUCCESS);
+    EXPECT_NE(stream.verified(), true);
+
+    // no signing key
+    EXPECT_THROW(OpenPGP::Verify::Stream(OpenPGP::SecretKey()), std::runtime_error);
+}
+
 TEST(PGP, sign_verify_cleartext) {
 
     OpenPGP::SecretKey pri;